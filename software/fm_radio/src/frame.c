@@ -0,0 +1,55 @@
+// ===================================================================================
+// Frame Rate Governor for OLED Rendering                                     * v1.0 *
+// ===================================================================================
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#include "frame.h"
+
+#define FRM_PERIOD      (F_CPU / FRM_FPS)             // system ticks per frame
+#define FRM_IDLE_TIME   (FRM_IDLE_MS * DLY_MS_TIME)   // system ticks without rendering
+
+// Frame governor variables
+uint16_t FRM_rendered;                                // number of frames rendered
+uint16_t FRM_skipped;                                 // number of frame slots skipped
+uint16_t FRM_renderTime;                              // last render time in us
+uint16_t FRM_renderAvg;                               // average render time in us
+uint8_t  FRM_changed = 1;                             // state has changed (render)
+uint32_t FRM_next;                                    // start of next frame slot
+uint32_t FRM_start;                                   // start of last rendered frame
+uint32_t FRM_renderSum;                               // 8 * average render time
+
+// Returns 1 once per frame slot
+uint8_t FRM_due(void) {
+  uint32_t now = STK->CNT;
+  if((int32_t)(now - FRM_next) < 0) return 0;         // slot not reached yet
+  FRM_next += FRM_PERIOD;                             // schedule next slot
+  if((int32_t)(now - FRM_next) >= 0)                  // fallen behind?
+    FRM_next = now + FRM_PERIOD;                      // -> resynchronize
+  return 1;
+}
+
+// Returns 1 if the frame should be rendered and starts render timer
+uint8_t FRM_begin(void) {
+  uint32_t now = STK->CNT;
+  #if FRM_ON_CHANGE > 0
+  #if FRM_IDLE_MS > 0
+  if(!FRM_changed && ((now - FRM_start) < FRM_IDLE_TIME)) {
+  #else
+  if(!FRM_changed) {
+  #endif
+    FRM_skipped++;                                    // nothing to render
+    return 0;
+  }
+  #endif
+  FRM_changed = 0;
+  FRM_start = now;                                    // start render timer
+  return 1;
+}
+
+// Stop render timer and update statistics
+void FRM_end(void) {
+  FRM_renderTime = (STK->CNT - FRM_start) / DLY_US_TIME;
+  FRM_renderSum += FRM_renderTime - (FRM_renderSum >> 3); // moving average
+  FRM_renderAvg  = FRM_renderSum >> 3;
+  FRM_rendered++;
+}
@@ -0,0 +1,68 @@
+// ===================================================================================
+// Frame Rate Governor for OLED Rendering                                     * v1.0 *
+// ===================================================================================
+//
+// Paces rendering to a fixed frame rate using the free-running SysTick counter,
+// independent of how fast the main loop spins. In change mode a frame is only
+// rendered if a state change was reported since the last frame, otherwise the frame
+// slot is skipped.
+//
+// Functions available:
+// --------------------
+// FRM_due()                returns 1 once per frame slot (target frame rate)
+// FRM_change()             report a state change (renders with the next slot)
+// FRM_begin()              returns 1 if the frame should be rendered, starts timer
+// FRM_end()                stop render timer and update statistics
+//
+// FRM_rendered             number of frames rendered
+// FRM_skipped              number of frame slots skipped (nothing has changed)
+// FRM_renderTime           render time of the last frame in us
+// FRM_renderAvg            average render time over the last 8 frames in us
+//
+// Example:
+// --------
+// if(FRM_due()) {                            // next frame slot reached
+//   if(RDA_updateStatus()) FRM_change();     // poll state once per frame
+//   if(FRM_begin()) {                        // something to render?
+//     render(); FRM_end();
+//   }
+// }
+//
+// Notes:
+// ------
+// - If the loop falls behind by more than one frame, the schedule is resynchronized
+//   instead of rendering several frames back-to-back.
+// - With FRM_IDLE_MS > 0 a frame is rendered at least every FRM_IDLE_MS
+//   milliseconds in change mode, to catch changes which are not reported.
+//
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "system.h"
+
+// Frame governor parameters
+#define FRM_FPS         25            // target frame rate in frames per second
+#define FRM_ON_CHANGE   1             // 1: render only on state change
+#define FRM_IDLE_MS     1000          // change mode: render at least every n ms (0: off)
+
+// Frame governor variables
+extern uint16_t FRM_rendered;
+extern uint16_t FRM_skipped;
+extern uint16_t FRM_renderTime;
+extern uint16_t FRM_renderAvg;
+extern uint8_t  FRM_changed;
+
+// Frame governor functions
+uint8_t FRM_due(void);                // returns 1 once per frame slot
+uint8_t FRM_begin(void);              // returns 1 if frame should be rendered
+void FRM_end(void);                   // stop render timer, update statistics
+#define FRM_change()    FRM_changed = 1
+
+#ifdef __cplusplus
+};
+#endif
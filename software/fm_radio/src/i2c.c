@@ -1,12 +1,60 @@
 // ===================================================================================
-// Basic I2C Master Functions for CH32V003                                    * v1.1 *
+// Basic I2C Master Functions for CH32V003                                    * v1.2 *
 // ===================================================================================
 // 2023 by Stefan Wagner:   https://github.com/wagiminator
 
 #include "i2c.h"
 
-// Read/write flag
+#if SYS_USE_VECTORS == 0
+  #error Interrupt vector table must be enabled (SYS_USE_VECTORS) for I2C DMA transfers!
+#endif
+
+// I2C pins (for bus recovery)
+#if   I2C_MAP == 0
+  #define I2C_GPIO  GPIOC
+  #define I2C_SDA   1
+  #define I2C_SCL   2
+#elif I2C_MAP == 1
+  #define I2C_GPIO  GPIOD
+  #define I2C_SDA   0
+  #define I2C_SCL   1
+#elif I2C_MAP == 2
+  #define I2C_GPIO  GPIOC
+  #define I2C_SDA   6
+  #define I2C_SCL   5
+#endif
+
+// Timing in system ticks
+#define I2C_TIMEOUT_TICKS ((uint32_t)I2C_TIMEOUT * DLY_US_TIME)   // timeout per wait
+#define I2C_BYTE_TICKS    ((uint32_t)9 * F_CPU / I2C_CLKRATE)     // one byte on the bus
+
+// Read/write flag and error state
 uint8_t I2C_rwflag;
+uint8_t I2C_error;                                // error of last blocking function
+
+// Statistics
+uint32_t I2C_timeLast;                            // duration of last transaction
+uint32_t I2C_timeMax;                             // longest transaction/wait
+uint16_t I2C_errorCount;                          // number of failed transfers
+uint16_t I2C_recoverCount;                        // number of bus recoveries
+
+// Transaction queues and state
+I2C_TRANS_t* I2C_queue[2][I2C_QUEUE];             // queues of pending transactions
+volatile uint8_t I2C_head[2], I2C_tail[2];        // queue write/read indices
+uint32_t I2C_stamp[I2C_QUEUE];                    // submit times of high priority queue
+uint32_t I2C_latencyLast;                         // last high priority latency
+uint32_t I2C_latencyMax;                          // longest high priority latency
+I2C_TRANS_t* volatile I2C_current;                // transaction in progress
+uint32_t I2C_startTime;                           // start time of current transaction
+uint32_t I2C_deadline;                            // allowed duration of current transaction
+const uint8_t* I2C_ptr;                           // current byte pointer
+uint16_t I2C_cnt;                                 // remaining bytes of current part
+uint8_t I2C_phase;                                // current part of the transaction
+volatile uint8_t I2C_recoverPending;              // bus must be recovered in main context
+enum{ I2C_PHASE_PRE, I2C_PHASE_WRITE, I2C_PHASE_READ };
+
+void I2C_next(void);
+void I2C_finish(uint8_t status);
 
 // Init I2C
 void I2C_init(void) {
@@ -42,54 +90,331 @@ void I2C_init(void) {
     I2C1->CKCFGR  = (F_CPU / (2 * I2C_CLKRATE));  // -> set clock division factor 1:1
   #endif
   I2C1->CTLR1   = I2C_CTLR1_PE;                   // enable I2C
+
+  // Setup DMA channels for transmission and reception
+  RCC->AHBPCENR |= RCC_DMA1EN;                    // enable DMA module clock
+  DMA1_Channel6->PADDR = (uint32_t)&I2C1->DATAR;  // TX peripheral address: I2C data register
+  DMA1_Channel7->PADDR = (uint32_t)&I2C1->DATAR;  // RX peripheral address: I2C data register
+  NVIC_EnableIRQ(DMA1_Channel7_IRQn);             // enable DMA RX transfer complete interrupt
+  NVIC_EnableIRQ(I2C1_EV_IRQn);                   // enable I2C event interrupt
+  NVIC_EnableIRQ(I2C1_ER_IRQn);                   // enable I2C error interrupt
 }
 
-// Start I2C transmission (addr must contain R/W bit)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunused-variable"
-void I2C_start(uint8_t addr) {
-  while(I2C1->STAR2 & I2C_STAR2_BUSY);            // wait until bus ready
+// Recover the bus: clock out a stuck slave, generate STOP and reset the I2C module
+void I2C_recover(void) {
+  I2C1->CTLR1 = 0;                                // disable I2C module
+  I2C_GPIO->BSHR  = ((uint32_t)1<<I2C_SDA) | ((uint32_t)1<<I2C_SCL);  // release lines
+  I2C_GPIO->CFGLR = (I2C_GPIO->CFGLR & ~(((uint32_t)0b1111<<(I2C_SDA<<2)) | ((uint32_t)0b1111<<(I2C_SCL<<2))))
+                                     |  (((uint32_t)0b0101<<(I2C_SDA<<2)) | ((uint32_t)0b0101<<(I2C_SCL<<2)));
+  for(uint8_t i=9; i && !(I2C_GPIO->INDR & ((uint32_t)1<<I2C_SDA)); i--) {
+    I2C_GPIO->BCR  = (uint32_t)1<<I2C_SCL;        // clock SCL until slave releases SDA
+    DLY_us(5);
+    I2C_GPIO->BSHR = (uint32_t)1<<I2C_SCL;
+    DLY_us(5);
+  }
+  I2C_GPIO->BCR  = (uint32_t)1<<I2C_SCL;          // generate STOP condition:
+  I2C_GPIO->BCR  = (uint32_t)1<<I2C_SDA;          // SDA low while SCL low,
+  DLY_us(5);
+  I2C_GPIO->BSHR = (uint32_t)1<<I2C_SCL;          // SCL high,
+  DLY_us(5);
+  I2C_GPIO->BSHR = (uint32_t)1<<I2C_SDA;          // SDA high
+  DLY_us(5);
+  RCC->APB1PRSTR |=  RCC_I2C1RST;                 // reset I2C module
+  RCC->APB1PRSTR &= ~RCC_I2C1RST;
+  I2C_init();                                     // init I2C again
+  I2C_recoverCount++;
+}
+
+// Handle error of a blocking function
+uint8_t I2C_fail(uint8_t error) {
+  if(error == I2C_ERR_NAK) {                      // slave did not acknowledge?
+    I2C1->STAR1 &= ~I2C_STAR1_AF;                 // -> clear flag
+    I2C1->CTLR1 |=  I2C_CTLR1_STOP;               // -> release the bus
+  }
+  else I2C_recover();                             // timeout: recover bus
+  I2C_errorCount++;
+  return(I2C_error = error);
+}
+
+// Wait for status flag with timeout, returns error code
+uint8_t I2C_waitFlag(uint16_t flag) {
+  uint32_t start = STK->CNT;
+  uint32_t time;
+  while(!(I2C1->STAR1 & flag)) {
+    if(I2C1->STAR1 & I2C_STAR1_AF) return I2C_fail(I2C_ERR_NAK);
+    if((STK->CNT - start) > I2C_TIMEOUT_TICKS) return I2C_fail(I2C_ERR_TIMEOUT);
+  }
+  time = STK->CNT - start;
+  if(time > I2C_timeMax) I2C_timeMax = time;
+  return I2C_OK;
+}
+
+// Start I2C transmission (addr must contain R/W bit), returns error code
+uint8_t I2C_start(uint8_t addr) {
+  uint32_t start;
+  I2C_error = I2C_OK;
+  while(I2C_busy());                              // wait for transactions to complete
+  start = STK->CNT;
+  while(I2C1->STAR2 & I2C_STAR2_BUSY) {           // wait until bus ready
+    if((STK->CNT - start) > I2C_TIMEOUT_TICKS) return I2C_fail(I2C_ERR_BUS);
+  }
   I2C1->CTLR1 |= I2C_CTLR1_START                  // set START condition
                | I2C_CTLR1_ACK;                   // set ACK
-  while(!(I2C1->STAR1 & I2C_STAR1_SB));           // wait for START generated
+  if(I2C_waitFlag(I2C_STAR1_SB)) return I2C_error;// wait for START generated
   I2C1->DATAR = addr;                             // send slave address + R/W bit
-  while(!(I2C1->STAR1 & I2C_STAR1_ADDR));         // wait for address transmitted
-  uint16_t reg = I2C1->STAR2;                     // clear flags
+  if(I2C_waitFlag(I2C_STAR1_ADDR)) return I2C_error;  // wait for address transmitted
+  (void)I2C1->STAR2;                              // clear flags
   I2C_rwflag = addr & 1;                          // set read/write flag
+  return I2C_OK;
 }
-#pragma GCC diagnostic pop
 
-// Send data byte via I2C bus
-void I2C_write(uint8_t data) {
-  while(!(I2C1->STAR1 & I2C_STAR1_TXE));          // wait for last byte transmitted
+// Send data byte via I2C bus, returns error code
+uint8_t I2C_write(uint8_t data) {
+  if(I2C_error) return I2C_error;                 // skip after error
+  if(I2C_waitFlag(I2C_STAR1_TXE)) return I2C_error; // wait for last byte transmitted
   I2C1->DATAR = data;                             // send data byte
+  return I2C_OK;
 }
 
 // Read data byte via I2C bus (ack=0 for last byte, ack>0 if more bytes to follow)
 uint8_t I2C_read(uint8_t ack) {
+  if(I2C_error) return 0xFF;                      // skip after error
   if(!ack) {                                      // last byte?
     I2C1->CTLR1 &= ~I2C_CTLR1_ACK;                // -> set NAK
     I2C1->CTLR1 |=  I2C_CTLR1_STOP;               // -> set STOP condition
   }
-  while(!(I2C1->STAR1 & I2C_STAR1_RXNE));         // wait for data byte received
+  if(I2C_waitFlag(I2C_STAR1_RXNE)) return 0xFF;   // wait for data byte received
   return I2C1->DATAR;                             // return received data byte
 }
 
-// Stop I2C transmission
-void I2C_stop(void) {
-  if(!I2C_rwflag) {                               // for read operation only
-    while(!(I2C1->STAR1 & I2C_STAR1_BTF));        // wait for last byte transmitted
+// Stop I2C transmission, returns error code
+uint8_t I2C_stop(void) {
+  if(I2C_error) return I2C_error;                 // STOP already sent after error
+  if(!I2C_rwflag) {                               // for write operation only
+    if(I2C_waitFlag(I2C_STAR1_BTF)) return I2C_error; // wait for last byte transmitted
     I2C1->CTLR1 |= I2C_CTLR1_STOP;                // set STOP condition
   }
+  return I2C_OK;
 }
 
-// Send data buffer via I2C bus and stop
-void I2C_writeBuffer(uint8_t* buf, uint16_t len) {
+// Send data buffer via I2C bus and stop, returns error code
+uint8_t I2C_writeBuffer(uint8_t* buf, uint16_t len) {
   while(len--) I2C_write(*buf++);           // write buffer
-  I2C_stop();                               // stop transmission
+  return I2C_stop();                        // stop transmission
 }
 
-// Read data via I2C bus to buffer and stop
-void I2C_readBuffer(uint8_t* buf, uint16_t len) {
+// Read data via I2C bus to buffer and stop, returns error code
+uint8_t I2C_readBuffer(uint8_t* buf, uint16_t len) {
   while(len--) *buf++ = I2C_read(len > 0);
+  return I2C_error;
+}
+
+// ===================================================================================
+// I2C Transaction Functions
+// ===================================================================================
+
+// Queue transaction, returns 0 if queued, 1 if queue is full
+uint8_t I2C_submit(I2C_TRANS_t* t) {
+  uint8_t result = 1;
+  uint8_t p = t->prio;
+  INT_ATOMIC_BLOCK {
+    uint8_t head = I2C_head[p];
+    uint8_t next = (head + 1) & (I2C_QUEUE - 1);
+    if(next != I2C_tail[p]) {                     // space left in the queue?
+      t->status = I2C_TRANS_QUEUED;               // mark transaction as queued
+      I2C_queue[p][head] = t;                     // put it into the queue
+      if(p) I2C_stamp[head] = STK->CNT;           // remember time of submission
+      I2C_head[p] = next;                         // increase write index
+      if(!I2C_current) I2C_next();                // start it if bus is idle
+      result = 0;
+    }
+  }
+  return result;
+}
+
+// Abort current transaction if it exceeds its deadline and recover the bus
+void I2C_check(void) {
+  uint8_t recover;
+  INT_ATOMIC_BLOCK {
+    if(I2C_current && ((STK->CNT - I2C_startTime) > I2C_deadline)) {
+      I2C_recoverPending = 1;                     // don't start the next one yet
+      I2C_finish(I2C_TRANS_ERROR);                // abort transaction
+    }
+    recover = I2C_recoverPending;
+  }
+  if(!recover) return;
+  I2C_recover();                                  // recover bus, interrupts enabled
+  INT_ATOMIC_BLOCK {
+    I2C_recoverPending = 0;
+    if(!I2C_current) I2C_next();                  // restart the queue
+  }
+}
+
+// Check if any transaction is in progress or queued
+uint8_t I2C_busy(void) {
+  I2C_check();
+  return(I2C_current || (I2C_head[0] != I2C_tail[0]) || (I2C_head[1] != I2C_tail[1]));
+}
+
+// Check if transaction is completed (or failed)
+uint8_t I2C_done(I2C_TRANS_t* t) {
+  I2C_check();
+  return((t->status != I2C_TRANS_QUEUED) && (t->status != I2C_TRANS_ACTIVE));
+}
+
+// Start next transaction from the queues (interrupts must be disabled)
+void I2C_next(void) {
+  uint32_t start;
+  uint8_t p = I2C_PRIO_HIGH;                      // high priority queue first
+  if(I2C_recoverPending) return;                  // I2C_check() restarts the queue
+  if(I2C_head[p] == I2C_tail[p]) {
+    p = I2C_PRIO_NORMAL;                          // then normal priority queue
+    if(I2C_head[p] == I2C_tail[p]) return;        // nothing to do
+  }
+  start = STK->CNT;
+  while(I2C1->CTLR1 & I2C_CTLR1_STOP) {           // wait for last STOP to complete
+    if((STK->CNT - start) > I2C_TIMEOUT_TICKS) {
+      I2C_recoverPending = 1;                     // stuck: recover in main context
+      return;
+    }
+  }
+  uint8_t tail = I2C_tail[p];
+  I2C_TRANS_t* t = I2C_queue[p][tail];            // get next transaction
+  I2C_tail[p] = (tail + 1) & (I2C_QUEUE - 1);     // increase read index
+  if(p) {                                         // high priority?
+    I2C_latencyLast = STK->CNT - I2C_stamp[tail]; // -> update latency statistics
+    if(I2C_latencyLast > I2C_latencyMax) I2C_latencyMax = I2C_latencyLast;
+  }
+  I2C_current = t;                                // set as current transaction
+  t->status = I2C_TRANS_ACTIVE;                   // mark transaction as active
+  I2C_phase = (t->plen || t->wlen) ? I2C_PHASE_PRE : I2C_PHASE_READ;
+  I2C_startTime = STK->CNT;                       // set deadline
+  I2C_deadline  = I2C_TIMEOUT_TICKS + (t->plen + t->wlen + t->rlen + 2) * 2 * I2C_BYTE_TICKS;
+  I2C1->CTLR2 |= I2C_CTLR2_ITEVTEN                // enable event interrupt
+               | I2C_CTLR2_ITERREN;               // enable error interrupt
+  I2C1->CTLR1 |= I2C_CTLR1_START                  // set START condition
+               | I2C_CTLR1_ACK;                   // set ACK
+}
+
+// Finish current transaction and start the next one
+void I2C_finish(uint8_t status) {
+  I2C_TRANS_t* t = I2C_current;
+  I2C1->CTLR2 &= ~(I2C_CTLR2_ITEVTEN | I2C_CTLR2_ITBUFEN | I2C_CTLR2_ITERREN
+                 | I2C_CTLR2_DMAEN   | I2C_CTLR2_LAST);
+  DMA1_Channel6->CFGR = 0;                        // disable DMA channels
+  DMA1_Channel7->CFGR = 0;
+  DMA1_Channel6->CNTR = 0;                        // no stale count after an abort
+  I2C_timeLast = STK->CNT - I2C_startTime;        // update statistics
+  if(I2C_timeLast > I2C_timeMax) I2C_timeMax = I2C_timeLast;
+  if(status != I2C_TRANS_DONE) I2C_errorCount++;
+  t->status = status;                             // set transaction status
+  if(t->callback) t->callback(t);                 // call user function
+  I2C_current = 0;                                // no transaction in progress
+  I2C_next();                                     // start next transaction
+}
+
+// Interrupt service routine for DMA receive complete (transaction read phase)
+void DMA1_Channel7_IRQHandler(void) __attribute__((interrupt));
+void DMA1_Channel7_IRQHandler(void) {
+  DMA1->INTFCR = DMA_CGIF7;                       // clear interrupt flags
+  I2C1->CTLR1 |= I2C_CTLR1_STOP;                  // last byte was NAKed, set STOP
+  if(I2C_current) I2C_finish(I2C_TRANS_DONE);     // transaction completed
+}
+
+// Interrupt service routine for I2C events
+void I2C1_EV_IRQHandler(void) __attribute__((interrupt));
+void I2C1_EV_IRQHandler(void) {
+  I2C_TRANS_t* t = I2C_current;
+  uint16_t star1 = I2C1->STAR1;                   // read status register 1
+
+  // START generated: send slave address with R/W bit
+  if(star1 & I2C_STAR1_SB) {
+    I2C1->DATAR = (t->addr << 1) | (I2C_phase == I2C_PHASE_READ);
+    return;
+  }
+
+  // Address transmitted
+  if(star1 & I2C_STAR1_ADDR) {
+    if(I2C_phase == I2C_PHASE_READ) {
+      if(t->rlen == 1) {                          // single byte?
+        I2C_ptr = t->rbuf;                        // -> receive it via RXNE interrupt
+        I2C_cnt = 1;
+        I2C1->CTLR1 &= ~I2C_CTLR1_ACK;            // -> NAK it
+        (void)I2C1->STAR2;                        // -> clear ADDR flag
+        I2C1->CTLR1 |=  I2C_CTLR1_STOP;           // -> STOP after it
+        I2C1->CTLR2 |=  I2C_CTLR2_ITBUFEN;        // -> enable RXNE interrupt
+        return;
+      }
+      DMA1_Channel7->MADDR = (uint32_t)t->rbuf;   // memory address: read buffer
+      DMA1_Channel7->CNTR  = t->rlen;             // number of bytes to transfer
+      DMA1_Channel7->CFGR  = DMA_CFGR1_MINC       // increment memory address
+                           | DMA_CFGR1_TCIE       // transfer complete interrupt enable
+                           | DMA_CFGR1_EN;        // enable channel
+      I2C1->CTLR2 |= I2C_CTLR2_DMAEN              // I2C: enable DMA requests
+                   | I2C_CTLR2_LAST;              // NAK last byte automatically
+      (void)I2C1->STAR2;                          // clear ADDR flag
+      return;                                     // DMA interrupt completes it
+    }
+    else {
+      I2C_ptr = t->pre;                           // set pointer to prefix
+      I2C_cnt = t->plen;                          // set number of prefix bytes
+      (void)I2C1->STAR2;                          // clear ADDR flag
+    }
+    I2C1->CTLR2 |= I2C_CTLR2_ITBUFEN;             // enable TXE/RXNE interrupt
+    return;
+  }
+
+  // Receive single data byte (more bytes are received via DMA)
+  if(I2C_phase == I2C_PHASE_READ) {
+    if((star1 & I2C_STAR1_RXNE) && (I2C1->CTLR2 & I2C_CTLR2_ITBUFEN)) {
+      *(uint8_t*)I2C_ptr = I2C1->DATAR;           // read received byte
+      I2C_finish(I2C_TRANS_DONE);                 // transaction completed
+    }
+    return;
+  }
+
+  // Transmit prefix bytes, then start DMA for the write buffer
+  if((star1 & I2C_STAR1_TXE) && (I2C1->CTLR2 & I2C_CTLR2_ITBUFEN)) {
+    if(I2C_cnt) {                                 // prefix bytes left?
+      I2C_cnt--;
+      I2C1->DATAR = *I2C_ptr++;                   // send next prefix byte
+      return;
+    }
+    I2C1->CTLR2 &= ~I2C_CTLR2_ITBUFEN;            // disable TXE interrupt
+    if((I2C_phase == I2C_PHASE_PRE) && t->wlen) { // something in the write buffer?
+      I2C_phase = I2C_PHASE_WRITE;
+      DMA1_Channel6->MADDR = (uint32_t)t->wbuf;   // memory address: write buffer
+      DMA1_Channel6->CNTR  = t->wlen;             // number of bytes to transfer
+      DMA1_Channel6->CFGR  = DMA_CFGR1_DIR        // memory to peripheral
+                           | DMA_CFGR1_MINC       // increment memory address
+                           | DMA_CFGR1_EN;        // enable channel
+      I2C1->CTLR2 |= I2C_CTLR2_DMAEN;             // I2C: enable DMA requests
+      return;
+    }
+  }
+
+  // All bytes transmitted (prefix only, or DMA write phase finished): STOP or
+  // repeated START for reading
+  if((star1 & I2C_STAR1_BTF) && (I2C_cnt == 0)
+    && ((I2C_phase == I2C_PHASE_PRE) || !(DMA1_Channel6->CNTR))) {
+    I2C1->CTLR2 &= ~I2C_CTLR2_DMAEN;              // I2C: disable DMA requests
+    DMA1_Channel6->CFGR = 0;                      // disable DMA channel
+    if(t->rlen) {                                 // something to read?
+      I2C_phase = I2C_PHASE_READ;
+      I2C1->CTLR2 &= ~I2C_CTLR2_ITBUFEN;
+      I2C1->CTLR1 |= I2C_CTLR1_START              // set repeated START condition
+                   | I2C_CTLR1_ACK;               // set ACK
+      return;
+    }
+    I2C1->CTLR1 |= I2C_CTLR1_STOP;                // set STOP condition
+    I2C_finish(I2C_TRANS_DONE);                   // transaction completed
+  }
+}
+
+// Interrupt service routine for I2C errors (NAK, bus error, arbitration lost, overrun)
+void I2C1_ER_IRQHandler(void) __attribute__((interrupt));
+void I2C1_ER_IRQHandler(void) {
+  I2C1->STAR1 &= ~(I2C_STAR1_BERR | I2C_STAR1_ARLO | I2C_STAR1_AF | I2C_STAR1_OVR);
+  I2C1->CTLR1 |= I2C_CTLR1_STOP;                  // release the bus
+  if(I2C_current) I2C_finish(I2C_TRANS_ERROR);    // abort transaction
 }
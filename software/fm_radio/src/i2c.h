@@ -1,5 +1,5 @@
 // ===================================================================================
-// Basic I2C Master Functions for CH32V003                                    * v1.1 *
+// Basic I2C Master Functions for CH32V003                                    * v1.2 *
 // ===================================================================================
 //
 // Functions available:
@@ -9,17 +9,64 @@
 // I2C_write(b)             I2C transmit one data byte via I2C
 // I2C_read(ack)            I2C receive one data byte (set ack=0 for last byte)
 // I2C_stop()               I2C stop transmission
+// I2C_recover()            Clock out stuck slave, generate STOP and reset I2C module
 //
 // I2C_writeBuffer(buf,len) Send buffer (*buf) with length (len) via I2C and stop
 // I2C_readBuffer(buf,len)  Read buffer (*buf) with length (len) via I2C and stop
 //
+// All blocking functions wait at most I2C_TIMEOUT microseconds for each bus event and
+// return an error code (I2C_OK, I2C_ERR_NAK, I2C_ERR_TIMEOUT, I2C_ERR_BUS). I2C_read()
+// returns the data byte, the error code can be found in I2C_error. After an error, the
+// following calls of the same transmission are skipped until the next I2C_start().
+// The bus is recovered automatically after a timeout.
+//
+// Interrupt-driven transactions:
+// ------------------------------
+// I2C_submit(*t)           Queue transaction (*t), returns 0 if queued, 1 if queue is full
+// I2C_done(*t)             Check if transaction (*t) is completed (or failed)
+// I2C_wait(*t)             Wait until transaction (*t) is completed (or failed)
+// I2C_busy()               Check if any transaction is in progress or queued
+// I2C_put(*t)              Queue transaction (*t), wait for a free queue slot
+// I2C_check()              Abort a transaction exceeding its deadline, recover the bus
+//
+// A transaction (I2C_TRANS_t) sends the prefix bytes (pre, plen) and the write buffer
+// (wbuf, wlen) to the slave and afterwards reads (rlen) bytes into the read buffer
+// (rbuf) using a repeated START. Each part is optional. Reads of two or more bytes are
+// done via DMA, the last byte is NAKed by hardware (LAST bit). The callback function
+// is called in interrupt context when the transaction is completed, it may submit
+// transactions, but must never wait for a free queue slot (the queue is drained by
+// interrupts only), defer the transaction to the main loop instead.
+// High priority transactions (prio=1) are always started before queued normal ones,
+// so long transfers should be split into chunks to keep the latency of them low.
+// I2C_latencyMax holds the longest wait (in system ticks) of a high priority
+// transaction from submission to START, read it on the target to check the worst
+// case of the actual application (expect about one OLED page chunk plus the queued
+// transactions of the same driver).
+//
+// Transactions exceeding their deadline (I2C_TIMEOUT plus twice their bus time) are
+// aborted with I2C_TRANS_ERROR and the bus is recovered. This is checked whenever
+// I2C_check(), I2C_busy(), I2C_done() or I2C_put() are called, so waiting with these
+// is bounded. The recovery runs with interrupts enabled and only in main context: if
+// a STOP gets stuck in interrupt context, the queue stops until the next check.
+// These functions must therefore not be called in interrupt context.
+// Statistics (in system ticks/counts): I2C_timeLast, I2C_timeMax, I2C_errorCount,
+// I2C_recoverCount.
+//
 // I2C pin mapping (set below in I2C parameters):
 // ----------------------------------------------
 // I2C_MAP    0     1     2
 // SDA-pin   PC1   PD0   PC6
 // SCL-pin   PC2   PD1   PC5
 //
-// External pull-up resistors (4k7 - 10k) are mandatory!
+// Notes:
+// ------
+// - External pull-up resistors (4k7 - 10k) are mandatory!
+// - Transactions use DMA1 channel 6 (TX) and 7 (RX), the latter with its interrupt
+//   (SYS_USE_VECTORS must be 1).
+// - Transactions use the I2C interrupts, the buffers are transferred via DMA.
+// - Buffers and descriptors must not be changed until the transfer is completed.
+//   I2C_start() automatically waits until all queued transactions are completed.
+//   Don't mix blocking functions and transactions submitted in interrupt context.
 // 2023 by Stefan Wagner:   https://github.com/wagiminator
 
 #pragma once
@@ -33,16 +80,59 @@ extern "C" {
 // I2C Parameters
 #define I2C_CLKRATE   400000    // I2C bus clock rate (Hz)
 #define I2C_MAP       0         // I2C pin mapping (see above)
+#define I2C_QUEUE     8         // transaction queue size per priority (power of 2)
+#define I2C_TIMEOUT   1000      // timeout for each bus event (us)
+
+// I2C Error Codes
+enum{ I2C_OK, I2C_ERR_NAK, I2C_ERR_TIMEOUT, I2C_ERR_BUS };
+extern uint8_t I2C_error;       // error code of last blocking function
 
 // I2C Functions
 void I2C_init(void);            // I2C init function
-void I2C_start(uint8_t addr);   // I2C start transmission, addr must contain R/W bit
-void I2C_stop(void);            // I2C stop transmission
-void I2C_write(uint8_t data);   // I2C transmit one data byte via I2C
+void I2C_recover(void);         // I2C bus recovery
+uint8_t I2C_start(uint8_t addr);// I2C start transmission, addr must contain R/W bit
+uint8_t I2C_stop(void);         // I2C stop transmission
+uint8_t I2C_write(uint8_t data);// I2C transmit one data byte via I2C
 uint8_t I2C_read(uint8_t ack);  // I2C receive one data byte from the slave
 
-void I2C_writeBuffer(uint8_t* buf, uint16_t len);
-void I2C_readBuffer(uint8_t* buf, uint16_t len);
+uint8_t I2C_writeBuffer(uint8_t* buf, uint16_t len);
+uint8_t I2C_readBuffer(uint8_t* buf, uint16_t len);
+
+// I2C Statistics
+extern uint32_t I2C_timeLast;   // duration of last transaction (system ticks)
+extern uint32_t I2C_timeMax;    // longest transaction or blocking wait (system ticks)
+extern uint16_t I2C_errorCount; // number of failed transfers
+extern uint16_t I2C_recoverCount; // number of bus recoveries
+
+// I2C Transaction Descriptor
+typedef struct I2C_TRANS {
+  const uint8_t* pre;           // pointer to prefix bytes (e.g. register or control byte)
+  const uint8_t* wbuf;          // pointer to write buffer
+  uint8_t* rbuf;                // pointer to read buffer
+  void (*callback)(struct I2C_TRANS* t);  // called when done (or NULL)
+  uint16_t wlen;                // number of bytes to write
+  uint16_t rlen;                // number of bytes to read
+  uint8_t  addr;                // 7-bit slave address
+  uint8_t  plen;                // number of prefix bytes
+  uint8_t  prio;                // priority (see below)
+  volatile uint8_t status;      // transaction status (see below)
+} I2C_TRANS_t;
+
+// I2C Transaction Priority and Status
+enum{ I2C_PRIO_NORMAL, I2C_PRIO_HIGH };
+enum{ I2C_TRANS_DONE, I2C_TRANS_QUEUED, I2C_TRANS_ACTIVE, I2C_TRANS_ERROR };
+
+// I2C Latency Statistics (in system ticks)
+extern uint32_t I2C_latencyLast;
+extern uint32_t I2C_latencyMax;
+
+// I2C Transaction Functions
+uint8_t I2C_submit(I2C_TRANS_t* t);
+uint8_t I2C_busy(void);
+uint8_t I2C_done(I2C_TRANS_t* t);
+void I2C_check(void);
+#define I2C_wait(t)     while(!I2C_done(t))
+#define I2C_put(t)      while(I2C_submit(t)) I2C_check()
 
 #ifdef __cplusplus
 };
@@ -58,6 +58,8 @@
 #include <gpio.h>                           // GPIO functions
 #include <ssd1306_gfx.h>                    // OLED functions
 #include <rda5807.h>                        // RDA 5807 functions
+#include <widget.h>                         // OLED widgets
+#include <frame.h>                          // frame rate governor
 
 // Global Variables
 uint8_t volume = RDA_INIT_VOL;              // current volume (0..15)
@@ -82,32 +84,71 @@ const uint8_t ANT[] = {
 };
 
 // ===================================================================================
-// OLED Update Function
+// OLED Widgets
 // ===================================================================================
-void OLED_update(void) {
-  RDA_updateStatus();
 
-  OLED_clear();
-  OLED_cursor(0, 0); OLED_textsize(OLED_SMOOTH); OLED_print(RDA_stationName);
-  OLED_drawBitmap(121, 0, 7, 16, PVD_isLow() ? BAT_WEAK : BAT_OK);
+// Draw station name
+void drawName(WGT_t* w) {
+  OLED_cursor(w->x, w->y); OLED_textsize(OLED_SMOOTH); OLED_print(((WGT_TEXT_t*)w)->text);
+}
 
-  OLED_cursor(-10, 20); OLED_printSegment(RDA_getFrequency(), 5, 1, 2);
-  OLED_cursor(94, 36); OLED_print("MHz");
+// Draw battery state
+void drawBattery(WGT_t* w) {
+  OLED_drawBitmap(w->x, w->y, 7, 16, w->value ? BAT_WEAK : BAT_OK);
+}
 
+// Draw frequency
+void drawFrequency(WGT_t* w) {
+  OLED_cursor(-10, w->y); OLED_printSegment(w->value, 5, 1, 2);
+}
+
+// Draw signal strength bar
+void drawStrength(WGT_t* w) {
+  if(w->value) OLED_fillRect(w->x, w->y, w->value, w->h, 1);
+}
+
+// Draw volume bar
+void drawVolume(WGT_t* w) {
+  uint8_t xpos = w->x - 5;
+  uint8_t vol  = w->value;
+  while(vol--) OLED_fillRect(xpos+=5, w->y, 4, w->h, 1);
+}
+
+// Widgets
+WGT_TEXT_t nameWidget  = { .wgt = { .x =   0, .y =  0, .w = 96, .h = 16, .draw = drawName } };
+WGT_t batteryWidget    = { .x = 121, .y =  0, .w =  7, .h = 16, .draw = drawBattery   };
+WGT_t frequencyWidget  = { .x =   0, .y = 20, .w = 88, .h = 32, .draw = drawFrequency,
+                           .opaque = 1 };     // only changed digits are redrawn
+WGT_t strengthWidget   = { .x = 106, .y = 22, .w = 20, .h =  3, .draw = drawStrength  };
+WGT_t volumeWidget     = { .x =  52, .y = 58, .w = 74, .h =  3, .draw = drawVolume    };
+
+// ===================================================================================
+// OLED Update Functions
+// ===================================================================================
+
+// Draw static screen elements (widgets are drawn with the next update)
+void OLED_setup(void) {
+  OLED_clear();
+  OLED_cursor(94, 36); OLED_textsize(1); OLED_print("MHz");
   OLED_drawBitmap(94, 20, 7, 8, ANT);
   OLED_drawRect(104, 20, 24, 7, 1);
+  OLED_cursor(0, 56); OLED_print("Volume:");
+  OLED_drawRect(50, 56, 78, 7, 1);
+}
+
+// Update widgets and send changed areas
+void OLED_update(void) {
   uint8_t strength = RDA_signalStrength;
   if(strength > 64) strength = 64;
   strength = (strength >> 2) + (strength >> 4);
-  if(strength) OLED_fillRect(106, 22, strength, 3, 1);
 
-  OLED_cursor(0, 56); OLED_textsize(1); OLED_print("Volume:");
-  OLED_drawRect(50, 56, 78, 7, 1);
-  uint8_t xpos = 47;
-  uint8_t vol  = volume;
-  while(vol--) OLED_fillRect(xpos+=5, 58, 4, 3, 1);
+  WGT_updateText(&nameWidget, RDA_stationName);
+  WGT_update(&batteryWidget, PVD_isLow() ? 1 : 0);
+  WGT_update(&frequencyWidget, RDA_getFrequency());
+  WGT_update(&strengthWidget, strength);
+  WGT_update(&volumeWidget, volume);
 
-  OLED_refresh();
+  OLED_refresh();                           // sends nothing if nothing has changed
 }
 
 // ===================================================================================
@@ -116,6 +157,8 @@ void OLED_update(void) {
 int main(void) {
   // Variables
   uint8_t CH_UP_state = 0;                  // CH+ button state
+  uint8_t VOL_UP_state = 0;                 // VOL+ button state
+  uint8_t VOL_DOWN_state = 0;               // VOL- button state
 
   // Setup
   PIN_input_PU(PIN_VOL_UP);                 // enable pullups for button pins
@@ -126,6 +169,7 @@ int main(void) {
   I2C_init();                               // init I2C
   OLED_init();                              // setup OLED
   RDA_init();                               // setup RDA tuner
+  OLED_setup();                             // draw static screen elements
   OLED_update();                            // draw screen
 
   // Set initial frequency
@@ -135,8 +179,17 @@ int main(void) {
 
   // Loop
   while(1) {
-    // Update information on OLED
-    OLED_update();
+    // Poll tuner (rate depends on tuner state, RDS groups are captured in background)
+    if(RDA_updateStatus()) FRM_change();    // channel, signal or name changed?
+
+    // Update information on OLED with the target frame rate
+    if(FRM_due() && FRM_begin()) {
+      OLED_update();
+      FRM_end();
+    }
+
+    // Decode captured RDS groups (after the frame, doesn't delay polling)
+    if(RDA_decodeRDS()) FRM_change();       // station name changed?
 
     // Check CH+ button
     if(!PIN_read(PIN_CH_UP)) {
@@ -147,16 +200,24 @@ int main(void) {
 
     // Check VOL+ button
     if(!PIN_read(PIN_VOL_UP)) {
-      if(volume < 15) volume++;
-      RDA_setVolume(volume);
-      while(!PIN_read(PIN_VOL_UP));
+      if(!VOL_UP_state) {
+        if(volume < 15) volume++;
+        RDA_setVolume(volume);
+        FRM_change();
+      }
+      DLY_ms(20);
     }
+    VOL_UP_state = !PIN_read(PIN_VOL_UP);
 
     // Check VOL- button
     if(!PIN_read(PIN_VOL_DOWN)) {
-      if(volume) volume--;
-      RDA_setVolume(volume);
-      while(!PIN_read(PIN_VOL_DOWN));
+      if(!VOL_DOWN_state) {
+        if(volume) volume--;
+        RDA_setVolume(volume);
+        FRM_change();
+      }
+      DLY_ms(20);
     }
+    VOL_DOWN_state = !PIN_read(PIN_VOL_DOWN);
   }
 }
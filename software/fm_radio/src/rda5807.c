@@ -1,5 +1,5 @@
 // ===================================================================================
-// RDA5807 Basic Functions                                                    * v1.1 *
+// RDA5807 Basic Functions                                                    * v1.2 *
 // ===================================================================================
 // 2022 by Stefan Wagner:   https://github.com/wagiminator
 
@@ -7,6 +7,9 @@
 
 // RDA register definitions
 uint16_t RDA_read_regs[6];                        // RDA registers for reading
+const uint16_t RDA_triggerBits[6] = {             // bits which start an action when written:
+  0x0102, 0x0010, 0, 0, 0, 0                      // 0x02: seek, soft reset; 0x03: tune
+};
 uint16_t RDA_write_regs[6] = {                    // RDA registers for writing:
   0b1101001000001101,                             // RDA register 0x02 preset
   0b0001010111000000,                             // RDA register 0x03 preset
@@ -17,40 +20,204 @@ uint16_t RDA_write_regs[6] = {                    // RDA registers for writing:
 };
 
 // RDA variables
-char RDA_stationName[9];                          // string for the station name
-char RDA_rdsStationName[8];                       // just for internal use
 const char RDA_header[9] = RDA_HEADER;            // default station name
+uint8_t RDA_pending;                              // background read result is wanted
+uint8_t RDA_changed;                              // station name was reset
+uint16_t RDA_nameTime;                            // time from tuned to name complete (ms)
+uint32_t RDA_tunedTime;                           // time tuning was completed
+
+// RDA I2C transactions
+void RDA_captureRDS(I2C_TRANS_t* t);
+uint8_t RDA_txbuf[12];                            // I2C transmit buffer
+uint8_t RDA_rxbuf[12];                            // I2C receive buffer
+I2C_TRANS_t RDA_tx = { .wbuf = RDA_txbuf, .prio = I2C_PRIO_HIGH };  // write transaction
+I2C_TRANS_t RDA_rx = { .rbuf = RDA_rxbuf, .prio = I2C_PRIO_HIGH,    // read transaction
+                       .addr = RDA_ADDR_SEQ, .callback = RDA_captureRDS };
+
+// RDS group ring buffer (written in interrupt, read by RDA_decodeRDS())
+typedef struct {
+  uint16_t blk[4];                                // blocks A-D
+  uint8_t  err;                                   // error levels of blocks A and B
+} RDA_GROUP_t;
+RDA_GROUP_t RDA_groups[RDA_RDS_BUF];              // captured groups
+volatile uint8_t RDA_groupHead;                   // write index (interrupt)
+uint8_t  RDA_groupTail;                           // read index
+uint16_t RDA_groupsCaptured;                      // number of groups captured
+uint16_t RDA_groupsDecoded;                       // number of groups decoded
+uint16_t RDA_groupsDropped;                       // number of groups lost (buffer full)
+
+// RDA shadow register handling
+uint8_t  RDA_dirty;                               // bitmask of registers to be written
+uint16_t RDA_bytesNaive;                          // bytes needed with single writes
+uint16_t RDA_bytesSent;                           // bytes actually sent
+uint16_t RDA_bytesSaved;                          // bus bytes saved per second
+uint32_t RDA_bytesTime;                           // start of current second
+uint16_t RDA_bytesRead[3];                        // bytes read in current second per state
+uint16_t RDA_bytesPolled[3];                      // bus bytes read per second per state
+
+// RDA poll scheduler
+uint8_t  RDA_pollState;                           // current poll state
+uint32_t RDA_pollNext;                            // time of next poll
+uint32_t RDA_pollTime;                            // state entry or last RDS group
+const uint8_t  RDA_pollRegs[3] = {                // registers to read in each state:
+  1, 2, 2                                         // REG_A, REG_A..B (..F if RDS ready)
+};
+const uint32_t RDA_pollTicks[3] = {               // poll interval in each state
+  RDA_POLL_TUNE_MS * DLY_MS_TIME,
+  RDA_POLL_RDS_MS  * DLY_MS_TIME,
+  RDA_POLL_IDLE_MS * DLY_MS_TIME
+};
+
+// RDA update saved bytes counter
+void RDA_countBytes(void) {
+  if((STK->CNT - RDA_bytesTime) >= (1000 * DLY_MS_TIME)) {
+    RDA_bytesTime  = STK->CNT;                    // start next second
+    RDA_bytesSaved = RDA_bytesNaive - RDA_bytesSent;
+    RDA_bytesNaive = 0;
+    RDA_bytesSent  = 0;
+    for(uint8_t i=0; i<3; i++) {
+      RDA_bytesPolled[i] = RDA_bytesRead[i];
+      RDA_bytesRead[i]   = 0;
+    }
+  }
+}
+
+// RDA modify shadow register (write it with next RDA_flushRegs())
+void RDA_modifyReg(uint8_t reg, uint16_t clr, uint16_t set) {
+  uint16_t val = (RDA_write_regs[reg] & ~clr) | set;
+  if(val == RDA_write_regs[reg]) return;          // nothing changed, nothing to write
+  RDA_bytesNaive += 4;                            // address + register + 2 bytes
+  RDA_write_regs[reg] = val;
+  RDA_dirty |= 1 << reg;                          // mark register as dirty
+}
+
+// RDA write all dirty registers with the least bus bytes
+void RDA_flushRegs(void) {
+  uint8_t last = 0, cnt = 0, seq = 1;
+  RDA_countBytes();                               // update statistics
+  if(!RDA_dirty) return;                          // nothing to write
+  for(uint8_t i=0; i<6; i++) {
+    if(RDA_dirty & (1 << i)) {
+      last = i; cnt++;                            // last dirty register
+    }
+  }
+  for(uint8_t i=0; i<last; i++) {                 // clean register in between...
+    if(!(RDA_dirty & (1 << i)) && (RDA_write_regs[i] & RDA_triggerBits[i]))
+      seq = 0;                                    // ...would trigger seek/tune again
+  }
+  if(seq && (3 + (last << 1) > (cnt << 2))) seq = 0; // indexed writes are cheaper
+  if(seq) {                                       // sequential write from 0x02:
+    I2C_wait(&RDA_tx);                            // wait for last write to complete
+    for(uint8_t i=0; i<=last; i++) {
+      RDA_txbuf[(i << 1)    ] = RDA_write_regs[i] >> 8; // high byte
+      RDA_txbuf[(i << 1) + 1] = RDA_write_regs[i];      // low byte
+    }
+    RDA_tx.addr = RDA_ADDR_SEQ;
+    RDA_tx.wlen = (last + 1) << 1;
+    RDA_bytesSent += RDA_tx.wlen + 1;             // address + data bytes
+    I2C_put(&RDA_tx);                             // queue transaction
+  }
+  else {                                          // indexed write of each register:
+    for(uint8_t i=0; i<=last; i++) {
+      if(!(RDA_dirty & (1 << i))) continue;
+      I2C_wait(&RDA_tx);                          // wait for last write to complete
+      RDA_txbuf[0] = 0x02 + i;                    // set the register to write
+      RDA_txbuf[1] = RDA_write_regs[i] >> 8;      // high byte
+      RDA_txbuf[2] = RDA_write_regs[i];           // low byte
+      RDA_tx.addr  = RDA_ADDR_INDEX;
+      RDA_tx.wlen  = 3;                           // register address + 2 bytes
+      RDA_bytesSent += 4;                         // address + data bytes
+      I2C_put(&RDA_tx);                           // queue transaction
+    }
+  }
+  RDA_dirty = 0;                                  // all changes are written
+}
 
 // RDA write specified register
 void RDA_writeReg(uint8_t reg) {
-  I2C_start((RDA_ADDR_INDEX << 1) | 0);           // start I2C for index write to RDA
-  I2C_write(0x02 + reg);                          // set the register to write
-  I2C_write(RDA_write_regs[reg] >> 8);            // send high byte
-  I2C_write(RDA_write_regs[reg]);                 // send low byte
-  I2C_stop();                                     // stop I2C
+  RDA_dirty |= 1 << reg;                          // mark register as dirty
+  RDA_bytesNaive += 4;
+  RDA_flushRegs();                                // write it
 }
 
 // RDA write all registers
 void RDA_writeAllRegs(void) {
-  I2C_start((RDA_ADDR_SEQ << 1) | 0);             // start I2C for sequential write to RDA
+  I2C_wait(&RDA_tx);                              // wait for last write to complete
   for(uint8_t i=0; i<6; i++) {                    // write to 6 registers
-    I2C_write(RDA_write_regs[i] >> 8);            // send high byte
-    I2C_write(RDA_write_regs[i]);                 // send low byte
+    RDA_txbuf[(i << 1)    ] = RDA_write_regs[i] >> 8; // high byte
+    RDA_txbuf[(i << 1) + 1] = RDA_write_regs[i];      // low byte
   }
-  I2C_stop();                                     // stop I2C
+  RDA_tx.addr  = RDA_ADDR_SEQ;                    // sequential write to RDA
+  RDA_tx.wlen  = 12;                              // 6 registers
+  RDA_bytesNaive += 13;                           // address + data bytes, nothing saved
+  RDA_bytesSent  += 13;
+  I2C_put(&RDA_tx);                               // queue transaction
+  RDA_dirty = 0;                                  // all registers are written
 }
 
-// RDA read all registers
-void RDA_readAllRegs(void) {
-  I2C_start((RDA_ADDR_SEQ << 1) | 1);             // start I2C for sequential read from RDA
-  for(uint8_t i=0; i<6; i++)                      // read 6 registers
-    RDA_read_regs[i] = (uint16_t)(I2C_read(1) << 8) | I2C_read(5-i);
-  I2C_stop();                                     // stop I2C
+// RDA convert received bytes to read registers (only the registers read)
+void RDA_convertRegs(void) {
+  for(uint8_t i=0; i<(RDA_rx.rlen >> 1); i++)     // convert bytes to registers
+    RDA_read_regs[i] = ((uint16_t)RDA_rxbuf[i << 1] << 8) | RDA_rxbuf[(i << 1) + 1];
+}
+
+// RDA request registers starting at 0x0A (read via DMA in the background)
+void RDA_requestRegs(uint8_t count) {
+  RDA_rx.rlen = count << 1;                       // number of bytes to read
+  RDA_bytesRead[RDA_pollState] += RDA_rx.rlen + 1; // address + data bytes
+  RDA_pending = 1;                                // result is wanted (for callback)
+  I2C_put(&RDA_rx);                               // queue transaction
+}
+
+// RDA read (count) registers starting at 0x0A
+void RDA_readRegs(uint8_t count) {
+  I2C_wait(&RDA_rx);                              // wait for pending read
+  RDA_requestRegs(count);                         // request registers
+  RDA_pending = 0;                                // don't decode it twice
+  I2C_wait(&RDA_rx);                              // wait for data
+  RDA_convertRegs();                              // convert bytes to registers
+}
+
+// RDA switch poll state
+void RDA_setPollState(uint8_t state) {
+  RDA_pollState = state;
+  RDA_pollTime  = STK->CNT;                       // start of state
+  RDA_pollNext  = STK->CNT;                       // poll now
+}
+
+// RDA update poll state after the registers were read
+void RDA_updatePollState(void) {
+  uint32_t elapsed = STK->CNT - RDA_pollTime;
+  switch(RDA_pollState) {
+    case RDA_POLL_TUNE:                           // seek/tune:
+      if(!RDA_isTuning) {                         // tuned:
+        RDA_setPollState(RDA_POLL_RDS);           // -> wait for RDS
+        RDA_tunedTime = STK->CNT;                 // start time-to-name measurement
+        RDA_nameTime  = 0;
+      }
+      break;
+    case RDA_POLL_RDS:                            // RDS data arriving:
+      if(RDA_hasRdsData && (RDA_rx.rlen == 12))
+        RDA_pollTime = STK->CNT;                  // group received, restart timeout
+      else if(elapsed >= RDA_RDS_TIMEOUT_MS * DLY_MS_TIME)
+        RDA_setPollState(RDA_POLL_IDLE);          // no RDS on this station
+      break;
+    default:                                      // idle:
+      if(elapsed >= RDA_IDLE_RDS_MS * DLY_MS_TIME)
+        RDA_setPollState(RDA_POLL_RDS);           // look for RDS again
+      break;
+  }
 }
 
 // RDA clear station
 void RDA_resetStation(void) {
+  RDA_pending   = 0;                              // discard outdated read
+  RDA_groupTail = RDA_groupHead;                  // discard groups of old station
+  RDS_reset();                                    // clear RDS data of old station
   for(uint8_t i=0; i<8; i++) RDA_stationName[i] = RDA_header[i];
+  RDA_changed = 1;
+  RDA_setPollState(RDA_POLL_TUNE);                // poll tuning state fast
+  RDA_pollNext += RDA_pollTicks[RDA_POLL_TUNE];   // give the tuner some time
 }
 
 // RDA initialize tuner
@@ -59,7 +226,6 @@ void RDA_init(void) {
   I2C_init();                                     // initialize I2C first
   #endif
   RDA_resetStation();                             // reset station available
-  RDA_stationName[8] = 0;                         // set string terminator
   RDA_write_regs[RDA_REG_2] |=  0x0002;           // set soft reset
   RDA_writeReg(RDA_REG_2);                        // write to register 0x02
   RDA_write_regs[RDA_REG_2] &= ~0x0002;           // clear soft reset
@@ -68,63 +234,99 @@ void RDA_init(void) {
 
 // RDA set volume
 void RDA_setVolume(uint8_t vol) {
-  RDA_write_regs[RDA_REG_5] &= ~0x000F;           // clear volume bits
-  RDA_write_regs[RDA_REG_5] |=  vol;              // set volume
-  RDA_writeReg(RDA_REG_5);                        // write to register 0x05
+  RDA_modifyReg(RDA_REG_5, 0x000F, vol);          // set volume bits
+  RDA_flushRegs();                                // write to register 0x05
 }
 
 // RDA tune to a specified channel
 void RDA_setChannel(uint16_t chan) {
-  RDA_resetStation();
-  RDA_write_regs[RDA_REG_3] &= ~0xFFC0;           // clear channel
-  RDA_write_regs[RDA_REG_3] |= (chan << 6) | 0x0010;  // set channel and tune enable
-  RDA_writeReg(RDA_REG_3);                        // write register
+  RDA_resetStation();                             // clear station name
+  RDA_modifyReg(RDA_REG_3, 0xFFC0, (chan << 6) | 0x0010); // set channel and tune enable
+  RDA_flushRegs();                                // write register
 }
 
 // RDA seek next channel
 void RDA_seekUp(void) {
   RDA_resetStation();                             // clear station name
-  RDA_write_regs[RDA_REG_2] |=  0x0100;           // set seek enable bit
-  RDA_writeReg(RDA_REG_2);                        // write to register 0x02
+  RDA_modifyReg(RDA_REG_2, 0, 0x0100);            // set seek enable bit
+  RDA_flushRegs();                                // write to register 0x02
 }
 
-// RDA update status and handle RDS
-void RDA_updateStatus(void) {
-  RDA_readAllRegs();                              // read all registers
+// RDA capture RDS group of a completed read (called in interrupt)
+void RDA_captureRDS(I2C_TRANS_t* t) {
+  RDA_GROUP_t* g;
+  if(!RDA_pending || (t->status != I2C_TRANS_DONE) || (t->rlen != 12)) return;
+  if(!(RDA_rxbuf[0] & 0x80) || (RDA_rxbuf[3] & 0x10)) return; // no group or block E
+  if((uint8_t)(RDA_groupHead - RDA_groupTail) >= RDA_RDS_BUF) {
+    RDA_groupsDropped++;                          // buffer is full
+    return;
+  }
+  g = &RDA_groups[RDA_groupHead & (RDA_RDS_BUF - 1)];
+  for(uint8_t i=0; i<4; i++)                      // REG_C..F: blocks A-D
+    g->blk[i] = ((uint16_t)RDA_rxbuf[(i << 1) + 4] << 8) | RDA_rxbuf[(i << 1) + 5];
+  g->err = RDA_rxbuf[3] & 0x0F;                   // BLERA, BLERB
+  RDA_groupHead++;
+  RDA_groupsCaptured++;
+}
+
+// RDA decode captured RDS groups, returns 1 if station name has changed
+uint8_t RDA_decodeRDS(void) {
+  uint8_t changed = 0;
+  while(RDA_groupTail != RDA_groupHead) {
+    RDA_GROUP_t* g = &RDA_groups[RDA_groupTail & (RDA_RDS_BUF - 1)];
+    if(RDS_decode(g->blk, g->err) & RDS_CHG_PS) changed = 1;
+    RDA_groupTail++;
+    RDA_groupsDecoded++;
+  }
+  if((RDS_nameShown == 0xFF) && !RDA_nameTime)    // name complete after tuning?
+    RDA_nameTime = (STK->CNT - RDA_tunedTime) / DLY_MS_TIME;
+  return changed;
+}
 
+// RDA handle status of the read registers
+void RDA_handleStatus(void) {
   // When tuned disable tuning and stop seeking
   if (!RDA_isTuning) {
-    RDA_write_regs[RDA_REG_3] &= ~0x0010;         // clear tune enable flag
-    RDA_writeReg(RDA_REG_3);
-    RDA_write_regs[RDA_REG_2] &= ~0x0100;         // clear seek enable flag
-    RDA_writeReg(RDA_REG_2);
+    RDA_modifyReg(RDA_REG_3, 0x0010, 0);          // clear tune enable flag
+    RDA_modifyReg(RDA_REG_2, 0x0100, 0);          // clear seek enable flag
   }
 
-  // Check for RDS data
-  if(RDA_hasRdsData) {                            // RDS ready?
-    // Toggle RDS flag to request new data
-    RDA_write_regs[RDA_REG_2] &= ~0x0008;         // clear RDS flag
-    RDA_writeReg(RDA_REG_2);                      // write to register 0x02
-    RDA_write_regs[RDA_REG_2] |=  0x0008;         // set RDS flag
-    RDA_writeReg(RDA_REG_2);                      // write to register 0x02
-
-    // Decode RDS message (station name)
-    if(!RDA_rdsBlockE) {                                         // REG_B..F carrying blocks A-D?
-      if( (RDA_read_regs[RDA_REG_D] & 0xF800) == 0x0000) {       // is it station name?
-        uint8_t offset = (RDA_read_regs[RDA_REG_D] & 0x03) << 1; // get character position
-        uint8_t c1 = RDA_read_regs[RDA_REG_F] >> 8;              // get character 1
-        uint8_t c2 = RDA_read_regs[RDA_REG_F];                   // get character 2
-
-        // Copy station name characters only if received twice in a row...
-        if(RDA_rdsStationName[offset] == c1)                     // 1st char received twice?
-             RDA_stationName[offset] = c1;                       // copy to station name
-        else RDA_rdsStationName[offset] = c1;                    // save for next test
-        if(RDA_rdsStationName[offset + 1] == c2)                 // 2nd char received twice?
-             RDA_stationName[offset + 1] = c2;                   // copy to station name
-        else RDA_rdsStationName[offset + 1] = c2;                // save for next test
-      }
-    }
+  // Check for RDS data (only if all registers were read, group was captured)
+  if(RDA_hasRdsData && (RDA_rx.rlen == 12)) {     // RDS ready?
+    // Toggle RDS flag to request new data (before the next read is queued)
+    RDA_modifyReg(RDA_REG_2, 0x0008, 0);          // clear RDS flag
+    RDA_flushRegs();                              // write with pending changes
+    RDA_modifyReg(RDA_REG_2, 0, 0x0008);          // set RDS flag
+    RDA_flushRegs();                              // write to register 0x02
+  }
+  RDA_flushRegs();                                // write all changed registers
+}
+
+// RDA update status and handle RDS (doesn't wait for the bus)
+// Returns 1 if channel, signal strength or station name (reset) have changed
+uint8_t RDA_updateStatus(void) {
+  uint8_t changed = RDA_changed;                  // name reset by tune/seek?
+  uint8_t count   = 0;                            // registers to read next
+  if(!I2C_done(&RDA_rx)) return 0;                // read still in progress
+  if(RDA_pending && (RDA_rx.status == I2C_TRANS_DONE)) {
+    uint16_t regA = RDA_read_regs[RDA_REG_A] & 0x03FF; // last channel
+    uint16_t regB = RDA_read_regs[RDA_REG_B] & 0xFE00; // last signal strength
+    RDA_pending = 0;
+    RDA_convertRegs();                            // convert bytes to registers
+    RDA_handleStatus();                           // handle status and RDS
+    if( (regA != (RDA_read_regs[RDA_REG_A] & 0x03FF))
+     || (regB != (RDA_read_regs[RDA_REG_B] & 0xFE00)) ) changed = 1;
+    RDA_updatePollState();                        // seek/tune, RDS or idle
+    if((RDA_pollState == RDA_POLL_RDS) && RDA_hasRdsData && (RDA_rx.rlen < 12))
+      count = 6;                                  // RDS group ready: read blocks now
+  }
+  RDA_changed = 0;
+  if(!count && ((int32_t)(STK->CNT - RDA_pollNext) >= 0)) { // next poll due?
+    RDA_pollNext = STK->CNT + RDA_pollTicks[RDA_pollState];
+    count = RDA_pollRegs[RDA_pollState];
   }
+  if(count) RDA_requestRegs(count);               // request next registers
+  return changed;
 }
 
 // Calculate frequency in 10kHz
@@ -136,6 +338,7 @@ uint16_t RDA_getFrequency(void) {
 void RDA_waitTuning(void) {
   do {
     DLY_ms(100);
-    RDA_updateStatus();
+    RDA_readRegs(1);                              // only REG_A (STC bit) is needed
+    RDA_handleStatus();
   } while(RDA_isTuning);
 }
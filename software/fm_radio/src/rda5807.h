@@ -1,5 +1,5 @@
 // ===================================================================================
-// RDA5807 Basic Functions                                                    * v1.1 *
+// RDA5807 Basic Functions                                                    * v1.2 *
 // ===================================================================================
 //
 // Basic functions for the RDA5807 digital stereo FM tuner IC.
@@ -10,11 +10,45 @@
 // RDA_setVolume(vol)       set volume
 // RDA_setChannel(chan)     tune to a specified channel
 // RDA_seekUp()             seek next channel
-// RDA_updateStatus()       update status and handle RDS
+// RDA_updateStatus()       update status and handle RDS (registers are read via DMA
+//                          in the background, each call decodes the last completed
+//                          read and requests the next one when it is due), returns
+//                          1 if channel, signal strength or station name (reset) have
+//                          changed
+// RDA_decodeRDS()          decode captured RDS groups (call when idle), returns 1 if
+//                          the station name has changed
+// RDA_readRegs(count)      read (count) registers starting at 0x0A (waits for data)
 // RDA_getFrequency()       calculate frequency in units of 10kHz
 // RDA_waitTuning()         wait until tuning completed
 //
-// RDA_stationName[]        contains current station name
+// RDA_stationName[]        contains current station name (RDS_stationName[])
+// RDA_bytesSaved           I2C bus bytes saved in the last second by coalescing writes
+// RDA_bytesPolled[state]   I2C bus bytes read in the last second by status polling,
+//                          counted per poll state (RDA_POLL_TUNE, _RDS or _IDLE)
+// RDA_pollState            current poll state (RDA_POLL_TUNE, _RDS or _IDLE)
+// RDA_nameTime             time from tuning completed to full station name in ms
+//                          (0: not complete yet)
+// RDA_groupsCaptured       number of RDS groups captured
+// RDA_groupsDecoded        number of RDS groups decoded
+// RDA_groupsDropped        number of RDS groups lost (ring buffer full)
+//
+// Changes to RDA_write_regs[] are collected in a dirty mask and flushed together,
+// either as one sequential write starting at register 0x02 or as indexed writes of
+// the changed registers, whichever needs less bus bytes. Clean registers holding a
+// seek/tune/reset bit are never rewritten.
+//
+// Status polling depends on the tuner state: during seek/tune only REG_A (STC bit,
+// channel) is read at a fast rate. When tuned, REG_A and REG_B are read faster than
+// the RDS group rate, followed by a read of all registers if an RDS group is ready.
+// If no RDS group arrived for RDA_RDS_TIMEOUT_MS, only REG_A and REG_B (RSSI) are
+// read at a slow rate, after RDA_IDLE_RDS_MS RDS is looked for again.
+//
+// RDS groups are copied into a ring buffer when a register read completes (in the
+// I2C interrupt) and decoded later by RDA_decodeRDS(), so decoding doesn't delay
+// the next poll while the main loop is busy, e.g. with an OLED frame. The groups are
+// decoded by rds.c (PI, PTY, PS, RT, CT, AF), the error levels of blocks A and B
+// (BLERA/BLERB) are passed along. The RDA5807 doesn't report the error levels of
+// blocks C and D, so the levels of A and B are used as an indicator.
 //
 // Further information:     https://github.com/wagiminator/ATtiny412-PocketRadio
 // 2022 by Stefan Wagner:   https://github.com/wagiminator
@@ -28,6 +62,7 @@ extern "C" {
 #include "config.h"
 #include "system.h"
 #include "i2c.h"                      // choose your I2C library
+#include "rds.h"                      // RDS group decoder
 
 // RDA parameters
 #define RDA_INIT_I2C    0             // init I2C with RDA_init()
@@ -38,6 +73,16 @@ extern "C" {
 #define RDA_HEADER      "FM Radio"    // default station name (8 characters)
 #endif
 
+// RDA poll scheduler parameters
+#define RDA_POLL_TUNE_MS    10        // seek/tune: read REG_A every n ms
+#define RDA_POLL_RDS_MS     40        // RDS: read REG_A..B every n ms (group: 87.6ms)
+#define RDA_POLL_IDLE_MS    500       // idle: read REG_A..B every n ms
+#define RDA_RDS_TIMEOUT_MS  2000      // no RDS group for n ms: go idle
+#define RDA_IDLE_RDS_MS     10000     // idle for n ms: look for RDS again
+
+// RDS group ring buffer
+#define RDA_RDS_BUF         8         // number of buffered RDS groups (power of 2)
+
 // RDA definitions
 #define RDA_ADDR_SEQ    0x10          // RDA5807 I2C device address for sequential access
 #define RDA_ADDR_INDEX  0x11          // RDA5807 I2C device address for indexed access
@@ -57,16 +102,26 @@ extern "C" {
 // RDA variables
 enum{ RDA_REG_2, RDA_REG_3, RDA_REG_4, RDA_REG_5, RDA_REG_6, RDA_REG_7 };
 enum{ RDA_REG_A, RDA_REG_B, RDA_REG_C, RDA_REG_D, RDA_REG_E, RDA_REG_F };
-extern char RDA_stationName[];
+#define RDA_stationName RDS_stationName
 extern uint16_t RDA_read_regs[];
 extern uint16_t RDA_write_regs[];
+extern uint16_t RDA_bytesSaved;
+extern uint16_t RDA_bytesPolled[3];
+enum{ RDA_POLL_TUNE, RDA_POLL_RDS, RDA_POLL_IDLE };
+extern uint8_t  RDA_pollState;
+extern uint16_t RDA_nameTime;
+extern uint16_t RDA_groupsCaptured;
+extern uint16_t RDA_groupsDecoded;
+extern uint16_t RDA_groupsDropped;
 
 // RDA functions
 void RDA_init(void);                  // RDA initialize tuner
 void RDA_setVolume(uint8_t vol);      // RDA set volume
 void RDA_setChannel(uint16_t chan);   // RDA tune to a specified channel
 void RDA_seekUp(void);                // RDA seek next channel
-void RDA_updateStatus(void);          // RDA update status and handle RDS
+uint8_t RDA_updateStatus(void);       // RDA update status, 1: status changed
+void RDA_readRegs(uint8_t count);     // RDA read (count) registers from 0x0A
+uint8_t RDA_decodeRDS(void);          // RDA decode captured RDS groups
 uint16_t RDA_getFrequency(void);      // Calculate frequency in units of 10kHz
 void RDA_waitTuning(void);            // Wait until tuning completed
 
@@ -0,0 +1,192 @@
+// ===================================================================================
+// RDS Group Decoder                                                          * v1.0 *
+// ===================================================================================
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#include "rds.h"
+
+// RDS variables
+uint16_t RDS_pi;                                  // program identification
+uint8_t  RDS_pty;                                 // program type
+uint8_t  RDS_tp;                                  // traffic program flag
+char     RDS_stationName[9];                      // program service name
+char     RDS_nameBuffer[8];                       // last received name characters
+uint8_t  RDS_nameMask;                            // name characters received twice
+uint8_t  RDS_nameShown;                           // name characters accepted
+uint8_t  RDS_changed;                             // changed data flags
+#if RDS_RT > 0
+char     RDS_radioText[65];                       // radio text
+uint8_t  RDS_textAB;                              // text A/B flag (clears text on toggle)
+#endif
+#if RDS_CT > 0
+uint32_t RDS_mjd;                                 // modified julian day
+uint8_t  RDS_hour, RDS_minute;                    // UTC
+int8_t   RDS_offset;                              // local time offset in half hours
+uint8_t  RDS_ctValid;                             // clock time was received
+#endif
+#if RDS_AF_MAX > 0
+uint8_t  RDS_af[RDS_AF_MAX];                      // alternative frequency codes
+uint8_t  RDS_afCount;                             // number of stored AF codes
+#endif
+
+// RDS clear all decoded data
+void RDS_reset(void) {
+  for(uint8_t i=0; i<8; i++) {
+    RDS_stationName[i] = ' ';
+    RDS_nameBuffer[i]  = 0;                       // don't confirm with old station
+  }
+  RDS_stationName[8] = 0;                         // string terminator
+  RDS_nameMask  = 0;
+  RDS_nameShown = 0;
+  RDS_pi  = 0;
+  RDS_pty = 0;
+  RDS_tp  = 0;
+  #if RDS_RT > 0
+  for(uint8_t i=0; i<64; i++) RDS_radioText[i] = ' ';
+  RDS_radioText[64] = 0;
+  RDS_textAB = 0xFF;                              // unknown
+  #endif
+  #if RDS_CT > 0
+  RDS_ctValid = 0;
+  #endif
+  #if RDS_AF_MAX > 0
+  RDS_afCount = 0;
+  #endif
+}
+
+// RDS store station name character, immediately if it was received error-free and
+// is printable, otherwise only if it was received twice in a row
+void RDS_putName(uint8_t pos, uint8_t c, uint8_t clean) {
+  uint8_t twice = (RDS_nameBuffer[pos] == c);     // received twice in a row?
+  RDS_nameBuffer[pos] = c;                        // save for next test
+  #if RDS_PS_FAST == 0
+  clean = 0;                                      // block D unchecked: always twice
+  #endif
+  if((c < 0x20) || (c > 0x7E)) clean = 0;         // not printable: don't trust it
+  if(RDS_nameMask & (1 << pos)) clean = 0;        // confirmed: change only if twice
+  if(!clean && !twice) return;                    // not accepted (yet)
+  if(RDS_stationName[pos] != c) RDS_changed |= RDS_CHG_PS;
+  RDS_stationName[pos] = c;                       // copy to station name
+  RDS_nameShown |= 1 << pos;                      // char is shown
+  if(twice) RDS_nameMask |= 1 << pos;             // char is confirmed
+}
+
+// RDS group 0A/0B: basic tuning and switching information (station name)
+void RDS_group0(const uint16_t* blk, uint8_t clean) {
+  uint8_t pos = (blk[1] & 0x03) << 1;             // character position
+  RDS_putName(pos,     blk[3] >> 8, clean);       // character 1
+  RDS_putName(pos + 1, blk[3],      clean);       // character 2
+}
+
+#if RDS_AF_MAX > 0
+// RDS store alternative frequency code (1..204: 87.6..107.9MHz)
+void RDS_putAF(uint8_t code) {
+  if(!code || (code > 204)) return;               // no frequency (count, filler)
+  for(uint8_t i=0; i<RDS_afCount; i++)
+    if(RDS_af[i] == code) return;                 // already stored
+  if(RDS_afCount >= RDS_AF_MAX) return;           // list is full
+  RDS_af[RDS_afCount++] = code;
+  RDS_changed |= RDS_CHG_AF;
+}
+
+// RDS group 0A: station name and alternative frequencies
+void RDS_group0A(const uint16_t* blk, uint8_t clean) {
+  if(clean && ((blk[2] >> 8) != 250)) {           // 250: LF/MF frequency follows
+    RDS_putAF(blk[2] >> 8);                       // AF code 1
+    RDS_putAF(blk[2]);                            // AF code 2
+  }
+  RDS_group0(blk, clean);
+}
+#else
+#define RDS_group0A     RDS_group0
+#endif
+
+#if RDS_RT > 0
+// RDS store radio text character (carriage return terminates the text)
+void RDS_putText(uint8_t pos, uint8_t c) {
+  if(c == 0x0D) c = 0;                            // end of text
+  if(RDS_radioText[pos] == c) return;
+  RDS_radioText[pos] = c;
+  RDS_changed |= RDS_CHG_RT;
+}
+
+// RDS group 2A/2B: radio text (A: 4 chars in blocks C/D, B: 2 chars in block D)
+void RDS_group2(const uint16_t* blk, uint8_t clean) {
+  if(!clean) return;                              // no second copy to check with
+  uint8_t ab = (blk[1] >> 4) & 1;                 // text A/B flag
+  if(ab != RDS_textAB) {                          // toggled: new text
+    for(uint8_t i=0; i<64; i++) RDS_radioText[i] = ' ';
+    RDS_textAB   = ab;
+    RDS_changed |= RDS_CHG_RT;
+  }
+  uint8_t pos = blk[1] & 0x0F;                    // text segment
+  if(blk[1] & 0x0800) {                           // version B:
+    pos <<= 1;
+  }
+  else {                                          // version A:
+    pos <<= 2;
+    RDS_putText(pos++, blk[2] >> 8);
+    RDS_putText(pos++, blk[2]);
+  }
+  RDS_putText(pos++, blk[3] >> 8);
+  RDS_putText(pos,   blk[3]);
+}
+#endif
+
+#if RDS_CT > 0
+// RDS group 4A: clock time and date
+void RDS_group4A(const uint16_t* blk, uint8_t clean) {
+  if(!clean) return;                              // no second copy to check with
+  uint8_t hour   = ((blk[2] & 1) << 4) | (blk[3] >> 12);
+  uint8_t minute = (blk[3] >> 6) & 0x3F;
+  if((hour > 23) || (minute > 59)) return;        // invalid time
+  RDS_mjd    = ((uint32_t)(blk[1] & 0x03) << 15) | (blk[2] >> 1);
+  RDS_hour   = hour;
+  RDS_minute = minute;
+  RDS_offset = blk[3] & 0x1F;                     // offset in half hours
+  if(blk[3] & 0x20) RDS_offset = -RDS_offset;     // negative offset
+  RDS_ctValid  = 1;
+  RDS_changed |= RDS_CHG_CT;
+}
+#endif
+
+// RDS group handlers (index: group type << 1 | version B)
+void (*const RDS_handlers[32])(const uint16_t* blk, uint8_t clean) = {
+  [0x00] = RDS_group0A,                           // 0A: PS, AF
+  [0x01] = RDS_group0,                            // 0B: PS
+  #if RDS_RT > 0
+  [0x04] = RDS_group2,                            // 2A: RT, 64 chars
+  [0x05] = RDS_group2,                            // 2B: RT, 32 chars
+  #endif
+  #if RDS_CT > 0
+  [0x08] = RDS_group4A,                           // 4A: CT
+  #endif
+};
+
+// RDS decode group, returns mask of changed data
+uint8_t RDS_decode(const uint16_t* blk, uint8_t err) {
+  void (*handler)(const uint16_t*, uint8_t);
+  if((err & 0x03) == 0x03) return 0;              // block B uncorrectable: drop group
+  RDS_changed = 0;
+
+  // Program identification (block A), program type and TP flag (block B)
+  if(!(err & 0x0C) && (blk[0] != RDS_pi)) {       // block A error-free, new PI?
+    #if RDS_AF_MAX > 0
+    if(RDS_pi) RDS_afCount = 0;                   // other program: clear AF list
+    #endif
+    RDS_pi = blk[0];
+    RDS_changed |= RDS_CHG_PI;
+  }
+  if(!(err & 0x03)) {                             // block B error-free?
+    uint8_t pty = (blk[1] >> 5) & 0x1F;
+    uint8_t tp  = (blk[1] >> 10) & 1;
+    if((pty != RDS_pty) || (tp != RDS_tp)) RDS_changed |= RDS_CHG_PI;
+    RDS_pty = pty;
+    RDS_tp  = tp;
+  }
+
+  // Group type specific data
+  handler = RDS_handlers[blk[1] >> 11];
+  if(handler) handler(blk, !err);                 // clean: blocks A and B error-free
+  return RDS_changed;
+}
@@ -0,0 +1,96 @@
+// ===================================================================================
+// RDS Group Decoder                                                          * v1.0 *
+// ===================================================================================
+//
+// Decodes RDS groups (blocks A-D) as delivered by tuner ICs like the RDA5807. The
+// group type in block B selects the handler from a table, unsupported group types
+// only update PI and PTY.
+//
+// Functions available:
+// --------------------
+// RDS_reset()              clear all decoded data (call after tuning)
+// RDS_decode(*blk,err)     decode group (blk[0..3] = blocks A..D), err: error levels
+//                          of block A (bits 3:2) and B (bits 1:0), 0: error-free,
+//                          3: uncorrectable; returns mask of changed data (RDS_CHG_*)
+// RDS_afFrequency(i)       frequency of alternative frequency (i) in units of 10kHz
+//
+// RDS_pi                   program identification
+// RDS_pty                  program type (0..31)
+// RDS_tp                   traffic program flag
+// RDS_stationName[]        program service name (PS, 8 chars), groups 0A/0B
+// RDS_radioText[]          radio text (RT, up to 64 chars), groups 2A/2B
+// RDS_mjd, RDS_hour,       clock time (CT, UTC) and local time offset in half hours,
+// RDS_minute, RDS_offset   group 4A (valid if RDS_ctValid is 1)
+// RDS_af[], RDS_afCount    alternative frequency codes (AF), group 0A
+//
+// Notes:
+// ------
+// - Groups with an uncorrectable block B are dropped, the group type is unknown.
+// - With RDS_PS_FAST 1, station name characters are accepted immediately if blocks A
+//   and B are error-free and the character is printable, otherwise only if received
+//   twice in a row. RDS_nameMask holds the characters received twice, RDS_nameShown
+//   all accepted. The characters are in block D, whose error level the RDA5807 does
+//   not report: a corrupted block D with error-free A and B shows a wrong character
+//   until the segment is received again (next 0A/0B cycle). It is not confirmed in
+//   RDS_nameMask, so polling goes on until it is corrected. RDS_PS_FAST 0 accepts
+//   characters only if received twice in a row.
+// - Radio text, clock time and AF are only taken from groups with error-free
+//   blocks A and B, there is no RAM for a second copy to compare with.
+//
+// References:
+// -----------
+// IEC 62106 / EN 50067, Specification of the Radio Data System (RDS)
+//
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// RDS parameters
+#define RDS_RT          1             // 1: decode radio text (needs 66 bytes RAM)
+#define RDS_CT          1             // 1: decode clock time
+#define RDS_AF_MAX      8             // max number of stored alternative frequencies
+#define RDS_PS_FAST     1             // 1: accept PS chars of groups with clean blocks A/B
+
+// RDS changed data flags (returned by RDS_decode())
+#define RDS_CHG_PS      0x01          // station name
+#define RDS_CHG_PI      0x02          // program identification, type or TP flag
+#define RDS_CHG_RT      0x04          // radio text
+#define RDS_CHG_CT      0x08          // clock time
+#define RDS_CHG_AF      0x10          // alternative frequencies
+
+// RDS variables
+extern uint16_t RDS_pi;
+extern uint8_t  RDS_pty;
+extern uint8_t  RDS_tp;
+extern char     RDS_stationName[];
+extern uint8_t  RDS_nameMask;
+extern uint8_t  RDS_nameShown;
+#if RDS_RT > 0
+extern char     RDS_radioText[];
+#endif
+#if RDS_CT > 0
+extern uint32_t RDS_mjd;
+extern uint8_t  RDS_hour;
+extern uint8_t  RDS_minute;
+extern int8_t   RDS_offset;
+extern uint8_t  RDS_ctValid;
+#endif
+#if RDS_AF_MAX > 0
+extern uint8_t  RDS_af[];
+extern uint8_t  RDS_afCount;
+#endif
+
+// RDS functions
+void RDS_reset(void);                                   // clear all decoded data
+uint8_t RDS_decode(const uint16_t* blk, uint8_t err);   // decode one group
+#define RDS_afFrequency(i)  (8750 + (uint16_t)RDS_af[i] * 10)
+
+#ifdef __cplusplus
+};
+#endif
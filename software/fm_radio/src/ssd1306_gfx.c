@@ -1,5 +1,5 @@
 // ===================================================================================
-// SSD1306/SH1106 I2C OLED Graphics Functions                                 * v1.6 *
+// SSD1306/SH1106 I2C OLED Graphics Functions                                 * v1.7 *
 // ===================================================================================
 // 2024 by Stefan Wagner:   https://github.com/wagiminator
 
@@ -8,7 +8,15 @@
 // ===================================================================================
 // Screen Buffer
 // ===================================================================================
+#if OLED_BANDED == 0
 uint8_t __attribute__ ((aligned(4))) OLED_buffer[OLED_WIDTH * OLED_HEIGHT / 8];
+#else
+uint8_t __attribute__ ((aligned(4))) OLED_buffer[OLED_WIDTH]; // one page (band) only
+#endif
+
+#if OLED_DOUBLEBUF > 0 && OLED_BANDED > 0
+  #error OLED_DOUBLEBUF and OLED_BANDED cannot be used together
+#endif
 
 #if OLED_DOUBLEBUF == 0
   #define OLED_drawbuffer OLED_buffer
@@ -19,43 +27,124 @@ uint8_t __attribute__ ((aligned(4))) OLED_buffer[OLED_WIDTH * OLED_HEIGHT / 8];
   uint8_t* OLED_sendbuffer = OLED_buffer2;
 #endif
 
+// Changed column span of each page (x0 > x1: page is unchanged)
+#define OLED_PAGE_NUM     (OLED_HEIGHT / 8)
+uint8_t OLED_dirtyX0[OLED_PAGE_NUM];
+uint8_t OLED_dirtyX1[OLED_PAGE_NUM];
+
+// Start of page in send buffer
+#if OLED_BANDED == 0
+  #define OLED_pagebuffer(p)  (OLED_sendbuffer + (p) * OLED_WIDTH)
+#else
+  #define OLED_pagebuffer(p)  (OLED_buffer)
+#endif
+
 // ===================================================================================
-// Standard ASCII 5x8 Font (chars 32 - 127)
+// Display List (banded mode)
 // ===================================================================================
-const uint8_t OLED_FONT[] = {
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x00,
-  0x14, 0x7F, 0x14, 0x7F, 0x14, 0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x23, 0x13, 0x08, 0x64, 0x62,
-  0x36, 0x49, 0x55, 0x22, 0x50, 0x00, 0x04, 0x03, 0x00, 0x00, 0x00, 0x1C, 0x22, 0x41, 0x00,
-  0x00, 0x41, 0x22, 0x1C, 0x00, 0x14, 0x08, 0x3E, 0x08, 0x14, 0x08, 0x08, 0x3E, 0x08, 0x08,
-  0x00, 0x80, 0x60, 0x00, 0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x60, 0x60, 0x00, 0x00,
-  0x20, 0x10, 0x08, 0x04, 0x02, 0x3E, 0x51, 0x49, 0x45, 0x3E, 0x44, 0x42, 0x7F, 0x40, 0x40,
-  0x42, 0x61, 0x51, 0x49, 0x46, 0x22, 0x41, 0x49, 0x49, 0x36, 0x18, 0x14, 0x12, 0x7F, 0x10,
-  0x2F, 0x49, 0x49, 0x49, 0x31, 0x3E, 0x49, 0x49, 0x49, 0x32, 0x03, 0x01, 0x71, 0x09, 0x07,
-  0x36, 0x49, 0x49, 0x49, 0x36, 0x26, 0x49, 0x49, 0x49, 0x3E, 0x00, 0x36, 0x36, 0x00, 0x00,
-  0x00, 0x80, 0x68, 0x00, 0x00, 0x00, 0x08, 0x14, 0x22, 0x00, 0x14, 0x14, 0x14, 0x14, 0x14,
-  0x00, 0x22, 0x14, 0x08, 0x00, 0x02, 0x01, 0x51, 0x09, 0x06, 0x3E, 0x41, 0x5D, 0x55, 0x5E,
-  0x7C, 0x12, 0x11, 0x12, 0x7C, 0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E, 0x41, 0x41, 0x41, 0x22,
-  0x7F, 0x41, 0x41, 0x22, 0x1C, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F, 0x09, 0x09, 0x09, 0x01,
-  0x3E, 0x41, 0x49, 0x49, 0x3A, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x41, 0x41, 0x7F, 0x41, 0x41,
-  0x20, 0x40, 0x41, 0x3F, 0x01, 0x7F, 0x08, 0x14, 0x22, 0x41, 0x7F, 0x40, 0x40, 0x40, 0x40,
-  0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E,
-  0x7F, 0x09, 0x09, 0x09, 0x06, 0x3E, 0x41, 0x41, 0xC1, 0xBE, 0x7F, 0x09, 0x19, 0x29, 0x46,
-  0x26, 0x49, 0x49, 0x49, 0x32, 0x01, 0x01, 0x7F, 0x01, 0x01, 0x3F, 0x40, 0x40, 0x40, 0x3F,
-  0x1F, 0x20, 0x40, 0x20, 0x1F, 0x3F, 0x40, 0x38, 0x40, 0x3F, 0x63, 0x14, 0x08, 0x14, 0x63,
-  0x07, 0x08, 0x70, 0x08, 0x07, 0x61, 0x51, 0x49, 0x45, 0x43, 0x00, 0x7F, 0x41, 0x41, 0x00,
-  0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x41, 0x41, 0x7F, 0x00, 0x08, 0x04, 0x02, 0x04, 0x08,
-  0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x06, 0x09, 0x09, 0x06, 0x20, 0x54, 0x54, 0x54, 0x78,
-  0x7F, 0x44, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x28, 0x38, 0x44, 0x44, 0x44, 0x7F,
-  0x38, 0x54, 0x54, 0x54, 0x18, 0x08, 0xFE, 0x09, 0x01, 0x02, 0x18, 0xA4, 0xA4, 0xA4, 0x78,
-  0x7F, 0x04, 0x04, 0x04, 0x78, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x80, 0x84, 0x7D, 0x00,
-  0x41, 0x7F, 0x10, 0x28, 0x44, 0x00, 0x41, 0x7F, 0x40, 0x00, 0x7C, 0x04, 0x7C, 0x04, 0x78,
-  0x7C, 0x04, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x44, 0x38, 0xFC, 0x24, 0x24, 0x24, 0x18,
-  0x18, 0x24, 0x24, 0x24, 0xFC, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x08, 0x54, 0x54, 0x54, 0x20,
-  0x04, 0x3F, 0x44, 0x40, 0x20, 0x3C, 0x40, 0x40, 0x40, 0x3C, 0x1C, 0x20, 0x40, 0x20, 0x1C,
-  0x3C, 0x40, 0x30, 0x40, 0x3C, 0x44, 0x28, 0x10, 0x28, 0x44, 0x1C, 0xA0, 0xA0, 0xA0, 0x7C,
-  0x44, 0x64, 0x54, 0x4C, 0x44, 0x08, 0x08, 0x36, 0x41, 0x41, 0x00, 0x00, 0xFF, 0x00, 0x00,
-  0x41, 0x41, 0x36, 0x08, 0x08, 0x08, 0x04, 0x08, 0x10, 0x08, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
-};
+// Drawing functions are recorded into the display list and replayed for each band
+// (page) by OLED_refresh(). Each record starts with the function code followed by
+// the 16-bit arguments (little-endian) and, for bitmaps, the pointer. Text is
+// recorded as runs of characters with position and style.
+#if OLED_BANDED > 0
+enum{ OLED_DL_PIXEL, OLED_DL_VLINE, OLED_DL_HLINE, OLED_DL_LINE, OLED_DL_RECT,
+      OLED_DL_FILLRECT, OLED_DL_CIRCLE, OLED_DL_FILLCIRCLE, OLED_DL_CLIP,
+      OLED_DL_SCREEN, OLED_DL_BITMAP, OLED_DL_SPRITE, OLED_DL_BITMAPXOR, OLED_DL_TEXT };
+const uint8_t OLED_DL_ARGS[] = { 3, 4, 4, 5, 5, 5, 4, 4, 4, 0, 4, 4, 4 }; // number of arguments
+
+uint8_t  OLED_dl[OLED_DL_SIZE];                   // display list
+uint16_t OLED_dlLen;                              // used bytes in display list
+uint16_t OLED_dlText;                             // start of last text record
+int16_t  OLED_dlTextEnd;                          // cursor position after last text record
+uint8_t  OLED_dlFull;                             // display list overflow flag
+uint8_t  OLED_replaying;                          // display list is being replayed
+uint8_t  OLED_bandY;                              // first line of current band
+
+// Record hook for drawing functions (returns from function when recorded)
+#define OLED_RECORD(op, a, b, c, d, e, p) \
+  if(!OLED_replaying) { OLED_record(op, a, b, c, d, e, p); return; }
+
+// Add record to display list
+void OLED_record(uint8_t op, int16_t a, int16_t b, int16_t c, int16_t d, int16_t e,
+                 const uint8_t* ptr) {
+  int16_t args[5] = { a, b, c, d, e };
+  uint8_t n = OLED_DL_ARGS[op];
+  uint8_t len = 1 + (n << 1) + ((op >= OLED_DL_SCREEN) ? sizeof(ptr) : 0);
+  if(OLED_dlLen + len > OLED_DL_SIZE) {           // no space left?
+    OLED_dlFull = 1;                              // -> set overflow flag
+    return;
+  }
+  uint8_t* p = OLED_dl + OLED_dlLen;
+  OLED_dlLen += len;
+  *p++ = op;
+  for(uint8_t i=0; i<n; i++) {
+    *p++ = args[i];
+    *p++ = args[i] >> 8;
+  }
+  if(op >= OLED_DL_SCREEN) {
+    uintptr_t addr = (uintptr_t)ptr;
+    for(uint8_t i=sizeof(ptr); i; i--, addr >>= 8) *p++ = addr;
+  }
+}
+#else
+#define OLED_RECORD(op, a, b, c, d, e, p)
+#endif
+
+// ===================================================================================
+// Clip Rectangle
+// ===================================================================================
+// Drawing functions intersect their bounding box with the clip rectangle (drawing
+// coordinates, inclusive) once and then draw with unchecked inner loops.
+
+// Screen size in drawing coordinates
+#if OLED_PORTRAIT == 0
+  #define OLED_XSIZE  OLED_WIDTH
+  #define OLED_YSIZE  OLED_HEIGHT
+#else
+  #define OLED_XSIZE  OLED_HEIGHT
+  #define OLED_YSIZE  OLED_WIDTH
+#endif
+
+int16_t OLED_clipX0 = 0;                          // clip rectangle
+int16_t OLED_clipY0 = 0;
+int16_t OLED_clipX1 = OLED_XSIZE - 1;
+int16_t OLED_clipY1 = OLED_YSIZE - 1;
+
+// Set clip rectangle starting from (x,y), width (w), height (h)
+void OLED_clip(int16_t x, int16_t y, int16_t w, int16_t h) {
+  #if OLED_BANDED > 0
+  if(!OLED_replaying) OLED_record(OLED_DL_CLIP, x, y, w, h, 0, 0);
+  #endif
+  OLED_clipX0 = (x < 0) ? 0 : x;                  // intersect with screen
+  OLED_clipY0 = (y < 0) ? 0 : y;
+  OLED_clipX1 = (x + w > OLED_XSIZE) ? (OLED_XSIZE - 1) : (x + w - 1);
+  OLED_clipY1 = (y + h > OLED_YSIZE) ? (OLED_YSIZE - 1) : (y + h - 1);
+}
+
+// Reset clip rectangle to complete screen
+void OLED_unclip(void) {
+  OLED_clip(0, 0, OLED_XSIZE, OLED_YSIZE);
+}
+
+// Check if pixel (x,y) is inside of clip rectangle
+#define OLED_clipPixel(x, y) \
+  (((x) >= OLED_clipX0) && ((x) <= OLED_clipX1) && ((y) >= OLED_clipY0) && ((y) <= OLED_clipY1))
+
+// Check if rectangle (x0..x1, y0..y1) is completely outside of clip rectangle
+#define OLED_clipOutside(x0, y0, x1, y1) \
+  (((x1) < OLED_clipX0) || ((x0) > OLED_clipX1) || ((y1) < OLED_clipY0) || ((y0) > OLED_clipY1))
+
+// Check if rectangle (x0..x1, y0..y1) is completely inside of clip rectangle
+#define OLED_clipInside(x0, y0, x1, y1) \
+  (((x0) >= OLED_clipX0) && ((x1) <= OLED_clipX1) && ((y0) >= OLED_clipY0) && ((y1) <= OLED_clipY1))
+
+// ===================================================================================
+// Fonts
+// ===================================================================================
+#include "ssd1306_font.h"                         // standard ASCII 5x8 font
+#if OLED_SMOOTH_TABLE > 0
+#include "ssd1306_smooth.h"                       // smoothed 12x16 font (generated)
+#endif
 
 // ===================================================================================
 // 13x32 7-Segment Font (0 - 9)
@@ -173,6 +262,7 @@ void OLED_init(void) {
   I2C_write(OLED_CMD_MODE);                       // set command mode
   I2C_writeBuffer((uint8_t*)OLED_INIT_CMD, sizeof(OLED_INIT_CMD)); // send the command bytes
   I2C_stop();                                     // stop transmission
+  OLED_invalidate();                              // display RAM content is unknown
 }
 
 // Switch display on/off (0: display off, 1: display on)
@@ -228,30 +318,272 @@ void OLED_home(uint8_t x, uint8_t y) {
   I2C_stop();                                     // stop transmission
 }
 
-// Refresh screen buffer (send buffer via I2C)
+// OLED I2C transactions
+void OLED_nextPage(I2C_TRANS_t* t);
+const uint8_t OLED_MODE[] = { OLED_CMD_MODE, OLED_DAT_MODE };
+uint8_t OLED_cmdbuf[6];                           // window commands
+I2C_TRANS_t OLED_cmdtrans = { .pre = &OLED_MODE[0], .plen = 1, .addr = OLED_ADDR,
+                              .wbuf = OLED_cmdbuf };
+#if OLED_SH1106 == 1 || OLED_WIDTH == 64
+// Page addressing: page/column commands (each with Co-bit set) precede the data
+// (Co-bit cleared) within the same transaction
+uint8_t OLED_pagepre[7] = { [6] = OLED_DAT_MODE }; // commands are filled in backwards
+uint8_t OLED_column;                              // column after last data (0xFF: unknown)
+I2C_TRANS_t OLED_dattrans = { .addr = OLED_ADDR, .callback = OLED_nextPage };
+#else
+I2C_TRANS_t OLED_dattrans = { .pre = &OLED_MODE[1], .plen = 1, .addr = OLED_ADDR,
+                              .callback = OLED_nextPage };
+#endif
+
+// Spans to be sent with the current refresh
+uint8_t OLED_sendX0[OLED_PAGE_NUM];
+uint8_t OLED_sendX1[OLED_PAGE_NUM];
+uint8_t OLED_sendPage, OLED_sendLast;             // current and last page to send
+uint16_t OLED_sentBytes;                          // screen data bytes of last refresh
+volatile uint8_t OLED_deferred;                   // couldn't be queued in callback:
+enum{ OLED_DEFER_NONE, OLED_DEFER_SPAN, OLED_DEFER_WINDOW }; // span, window and span
+
+// Checksums of the pages shown on the display
+#if OLED_PAGE_HASH > 0
+uint16_t OLED_pageHash[OLED_PAGE_NUM];
+uint8_t  OLED_hashValid;                          // bit n: checksum of page n is valid
+uint16_t OLED_pagesSent;                          // number of sent pages
+uint16_t OLED_pagesSkipped;                       // number of pages skipped by checksum
+
+// CRC-16-CCITT nibble table
+const uint16_t OLED_CRC_TABLE[] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+// Check if page content differs from display, remember its checksum (CRC-16)
+uint8_t OLED_pageChanged(uint8_t page, const uint8_t* ptr) {
+  uint16_t crc = 0xFFFF;
+  for(uint8_t i=OLED_WIDTH; i; i--) {
+    crc ^= (uint16_t)*ptr++ << 8;
+    crc = (crc << 4) ^ OLED_CRC_TABLE[crc >> 12];
+    crc = (crc << 4) ^ OLED_CRC_TABLE[crc >> 12];
+  }
+  if((OLED_hashValid & (1 << page)) && (crc == OLED_pageHash[page])) {
+    OLED_pagesSkipped++;
+    return 0;
+  }
+  OLED_pageHash[page] = crc;
+  OLED_hashValid |= 1 << page;
+  OLED_pagesSent++;
+  return 1;
+}
+#endif
+
+// Mark column span (x0..x1) of page as changed
+void OLED_markDirty(uint8_t page, uint8_t x0, uint8_t x1) {
+  if(x0 < OLED_dirtyX0[page]) OLED_dirtyX0[page] = x0;
+  if(x1 > OLED_dirtyX1[page]) OLED_dirtyX1[page] = x1;
+}
+
+// Mark complete screen as changed (pages matching their checksum are still skipped)
+void OLED_markAll(void) {
+  for(uint8_t i=0; i<OLED_PAGE_NUM; i++) OLED_markDirty(i, 0, OLED_WIDTH - 1);
+}
+
+// Mark complete screen as changed, display content is unknown
+void OLED_invalidate(void) {
+  OLED_markAll();
+  #if OLED_PAGE_HASH > 0
+  OLED_hashValid = 0;                             // send all pages again
+  #endif
+}
+
+// Prepare transaction to send span of current page
+void OLED_prepareSpan(void) {
+  uint8_t page = OLED_sendPage;
+  uint8_t x0   = OLED_sendX0[page];
+  OLED_dattrans.wbuf = OLED_pagebuffer(page) + x0;
+  OLED_dattrans.wlen = OLED_sendX1[page] - x0 + 1;
+  OLED_sentBytes += OLED_dattrans.wlen;
+  #if OLED_SH1106 == 1 || OLED_WIDTH == 64
+  uint8_t* pre = &OLED_pagepre[6];                // page addressing:
+  x0 += OLED_XOFF;                                // column nibbles only if changed
+  if((OLED_column == 0xFF) || ((OLED_column ^ x0) & 0xF0)) {
+    *--pre = OLED_COLUMN_HIGH | (x0 >> 4);
+    *--pre = OLED_CMD_ONCE;
+  }
+  if((OLED_column == 0xFF) || ((OLED_column ^ x0) & 0x0F)) {
+    *--pre = OLED_COLUMN_LOW  | (x0 & 0xf);
+    *--pre = OLED_CMD_ONCE;
+  }
+  *--pre = OLED_PAGE | (OLED_YOFF / 8 + page);    // set page
+  *--pre = OLED_CMD_ONCE;
+  OLED_dattrans.pre  = pre;
+  OLED_dattrans.plen = &OLED_pagepre[7] - pre;
+  OLED_column = x0 + OLED_dattrans.wlen;          // column is incremented with data
+  #endif
+}
+
+// Queue transaction to send span of current page (not in interrupt context)
+void OLED_sendSpan(void) {
+  OLED_prepareSpan();
+  I2C_put(&OLED_dattrans);                        // queue start address and screen data
+}
+
+// Prepare transaction to set column/page window (horizontal addressing mode)
+void OLED_prepareWindow(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  OLED_cmdbuf[0] = OLED_COLUMNS;
+  OLED_cmdbuf[1] = OLED_XOFF + x0;
+  OLED_cmdbuf[2] = OLED_XOFF + x1;
+  OLED_cmdbuf[3] = OLED_PAGES;
+  OLED_cmdbuf[4] = OLED_YOFF + p0;
+  OLED_cmdbuf[5] = OLED_YOFF + p1;
+  OLED_cmdtrans.wlen = 6;
+}
+
+// Queue transaction to set column/page window (not in interrupt context)
+void OLED_sendWindow(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  OLED_prepareWindow(x0, x1, p0, p1);
+  I2C_put(&OLED_cmdtrans);                        // queue window
+}
+
+// Screen data is sent page by page, the next page is queued when the last one is done.
+// This way high priority transactions (e.g. of the tuner) get the bus in between.
+// This runs in interrupt context, if the queue is full the page is deferred and
+// queued by OLED_busy() instead of waiting here (the queue is drained by interrupts).
+void OLED_nextPage(I2C_TRANS_t* t) {
+  #if OLED_PAGE_HASH > 0 && OLED_SH1106 == 0 && OLED_WIDTH != 64
+  uint8_t gap = 0;
+  #endif
+  while(OLED_sendPage < OLED_sendLast) {
+    OLED_sendPage++;
+    if(OLED_sendX0[OLED_sendPage] <= OLED_sendX1[OLED_sendPage]) {
+      OLED_prepareSpan();                         // next changed page
+      #if OLED_PAGE_HASH > 0 && OLED_SH1106 == 0 && OLED_WIDTH != 64
+      if(gap) {                                   // skipped pages: new window
+        OLED_prepareWindow(OLED_sendX0[OLED_sendPage], OLED_sendX1[OLED_sendPage],
+                           OLED_sendPage, OLED_sendLast);
+        if(I2C_submit(&OLED_cmdtrans)) {
+          OLED_deferred = OLED_DEFER_WINDOW;      // queue full: send it later
+          return;
+        }
+      }
+      #endif
+      if(I2C_submit(&OLED_dattrans))
+        OLED_deferred = OLED_DEFER_SPAN;          // queue full: send it later
+      return;
+    }
+    #if OLED_PAGE_HASH > 0 && OLED_SH1106 == 0 && OLED_WIDTH != 64
+    gap = 1;
+    #endif
+  }
+}
+
+// Check if screen buffer is still being sent, queue deferred page
+uint8_t OLED_busy(void) {
+  if(OLED_deferred) {                             // no page transaction in flight:
+    if(OLED_deferred == OLED_DEFER_WINDOW) {
+      if(I2C_submit(&OLED_cmdtrans)) return 1;    // queue still full
+      OLED_deferred = OLED_DEFER_SPAN;
+    }
+    OLED_deferred = OLED_DEFER_NONE;              // cleared before its callback can run
+    if(I2C_submit(&OLED_dattrans)) OLED_deferred = OLED_DEFER_SPAN;
+    return 1;
+  }
+  return !I2C_done(&OLED_dattrans);
+}
+
+#if OLED_BANDED > 0
+void OLED_replay(void);
+
+// Refresh screen (render and send band by band, last band is sent in the background)
 void OLED_refresh(void) {
+  uint8_t gap = 1;                                // window has to be set
+  while(OLED_busy());                             // wait for last refresh to complete
+  OLED_sentBytes = 0;
+  #if OLED_SH1106 == 1 || OLED_WIDTH == 64
+  OLED_column = 0xFF;                             // start with complete address
+  #endif
+  for(uint8_t page=0; page<OLED_PAGE_NUM; page++) {
+    uint32_t* ptr = (uint32_t*)OLED_buffer;
+    uint8_t   cnt = OLED_WIDTH >> 2;
+    while(OLED_busy());                           // wait for band buffer to be sent
+    while(cnt--) *ptr++ = (uint32_t)0;            // clear band buffer
+    OLED_bandY = page << 3;
+    OLED_replay();                                // render band
+    #if OLED_PAGE_HASH > 0
+    if(!OLED_pageChanged(page, OLED_buffer)) {    // band is shown already
+      gap = 1;
+      continue;
+    }
+    #endif
+    #if OLED_SH1106 == 0 && OLED_WIDTH != 64
+    if(gap) OLED_sendWindow(0, OLED_WIDTH - 1, page, OLED_PAGE_NUM - 1);
+    #endif
+    gap = 0;
+    OLED_sendX0[page] = 0;
+    OLED_sendX1[page] = OLED_WIDTH - 1;
+    OLED_sendPage = page;
+    OLED_sendLast = page;
+    OLED_sendSpan();                              // send band
+  }
+}
+
+#else
+
+// Refresh screen buffer (send changed areas via I2C in the background)
+void OLED_refresh(void) {
+  uint8_t first = 0xFF, last = 0, x0 = 0xFF, x1 = 0;
+  while(OLED_busy());                             // wait for last refresh to complete
+
   #if OLED_DOUBLEBUF > 0
   uint8_t* temp = OLED_drawbuffer;                // switch buffers
   OLED_drawbuffer = OLED_sendbuffer;
   OLED_sendbuffer = temp;
   #endif
 
-  #if OLED_SH1106 == 1 || OLED_WIDTH == 64
-  uint8_t* buffer = OLED_sendbuffer;
-  for(uint8_t y=0; y<OLED_HEIGHT; y+=8) {         // each page must be transmitted individually
-    OLED_home(OLED_XOFF, OLED_YOFF + y);          // set page
-    I2C_start(OLED_ADDR << 1);                    // start transmission to OLED
-    I2C_write(OLED_DAT_MODE);                     // set command mode
-    I2C_writeBuffer(buffer, OLED_WIDTH);          // transmit page
-    buffer += OLED_WIDTH;                         // increase buffer pointer
+  // Take over changed spans
+  for(uint8_t i=0; i<OLED_PAGE_NUM; i++) {
+    OLED_sendX0[i] = OLED_dirtyX0[i];
+    OLED_sendX1[i] = OLED_dirtyX1[i];
+    #if OLED_DOUBLEBUF > 0
+    for(uint8_t x=OLED_sendX0[i]; x<=OLED_sendX1[i]; x++) // copy changes into the new
+      OLED_drawbuffer[i * OLED_WIDTH + x] = OLED_pagebuffer(i)[x]; // draw buffer
+    #endif
+    OLED_dirtyX0[i] = 0xFF;                       // mark page as unchanged
+    OLED_dirtyX1[i] = 0;
+    if(OLED_sendX0[i] > OLED_sendX1[i]) continue; // page unchanged
+    #if OLED_PAGE_HASH > 0
+    if(!OLED_pageChanged(i, OLED_pagebuffer(i))) { // page is shown already
+      OLED_sendX0[i] = 0xFF;
+      OLED_sendX1[i] = 0;
+      continue;
+    }
+    #endif
+    if(first == 0xFF) first = i;
+    last = i;
+    if(OLED_sendX0[i] < x0) x0 = OLED_sendX0[i];
+    if(OLED_sendX1[i] > x1) x1 = OLED_sendX1[i];
   }
-  #else
-  OLED_home(OLED_XOFF, OLED_YOFF);                // set start address
-  I2C_start(OLED_ADDR << 1);                      // start transmission to OLED
-  I2C_write(OLED_DAT_MODE);                       // set command mode
-  I2C_writeBuffer(OLED_sendbuffer, sizeof(OLED_buffer)); // send screen buffer using DMA
+  OLED_sentBytes = 0;
+  if(first == 0xFF) return;                       // nothing has changed
+
+  #if OLED_SH1106 == 0 && OLED_WIDTH != 64
+  // Horizontal addressing: set window around all changed spans, send page by page
+  OLED_sendWindow(x0, x1, first, last);
+  for(uint8_t i=first; i<=last; i++) {
+    #if OLED_PAGE_HASH > 0
+    if(OLED_sendX0[i] > OLED_sendX1[i]) continue; // skipped page
+    #endif
+    OLED_sendX0[i] = x0;
+    OLED_sendX1[i] = x1;
+  }
+  #endif
+
+  #if OLED_SH1106 == 1 || OLED_WIDTH == 64
+  OLED_column = 0xFF;                             // start with complete address
   #endif
+  OLED_sendPage = first;
+  OLED_sendLast = last;
+  OLED_sendSpan();                                // send first changed page
 }
+#endif
 
 // ===================================================================================
 // OLED Graphics Functions
@@ -259,9 +591,33 @@ void OLED_refresh(void) {
 
 // Clear OLED screen buffer
 void OLED_clear(void) {
+  OLED_segInvalidate();                           // 7-segment cells are cleared
+  #if OLED_BANDED > 0
+  OLED_dlLen  = 0;                                // empty display list
+  OLED_dlFull = 0;
+  OLED_dlText = 0;                                // no text record to append to
+  OLED_dlTextEnd = INT16_MIN;
+  if( OLED_clipX0 || OLED_clipY0 || (OLED_clipX1 != OLED_XSIZE - 1)
+   || (OLED_clipY1 != OLED_YSIZE - 1)) {          // keep clip rectangle
+    OLED_record(OLED_DL_CLIP, OLED_clipX0, OLED_clipY0, OLED_clipX1 - OLED_clipX0 + 1,
+                OLED_clipY1 - OLED_clipY0 + 1, 0, 0);
+  }
+  #else
+  #if OLED_DOUBLEBUF == 0
+  while(OLED_busy());                             // wait for screen buffer to be sent
+  #endif
   uint32_t* ptr = (uint32_t*)OLED_drawbuffer;
-  uint32_t  cnt = sizeof(OLED_buffer) >> 2;
-  while(cnt--) *ptr++ = (uint32_t)0;
+  for(uint8_t page=0; page<OLED_PAGE_NUM; page++) {
+    uint8_t x0 = 0xFF, x1 = 0;
+    for(uint8_t x=0; x<OLED_WIDTH; x+=4, ptr++) {
+      if(!*ptr) continue;                         // only set pixels change
+      if(x0 == 0xFF) x0 = x;
+      x1 = x + 3;
+      *ptr = (uint32_t)0;
+    }
+    if(x0 != 0xFF) OLED_markDirty(page, x0, x1);
+  }
+  #endif
 }
 
 // Copy OLED screen buffer
@@ -270,67 +626,191 @@ void OLED_copy(void) {
   uint32_t* dptr = (uint32_t*)OLED_drawbuffer;
   uint32_t  cnt  = sizeof(OLED_buffer) >> 2;
   while(cnt--) *dptr++ = *sptr++;
+  OLED_segInvalidate();
+  OLED_markAll();
 }
 
 // Get pixel color at (x,y) (0: pixel cleared, 1: pixel set)
 uint8_t OLED_getPixel(int16_t x, int16_t y) {
   #if OLED_PORTRAIT == 0
   if((x < 0) || (x >= OLED_WIDTH) || (y < 0) || (y >= OLED_HEIGHT)) return 0;
-  return((OLED_drawbuffer[((uint16_t)y >> 3) * OLED_WIDTH + x] >> (y & 7)) & 1);
   #else
-  x = (int16_t)(OLED_HEIGHT - 1) - x;
-  if((x < 0) || (x >= OLED_HEIGHT) || (y < 0) || (y >= OLED_WIDTH)) return 0;
-  return((OLED_drawbuffer[((uint16_t)x >> 3) * OLED_WIDTH + y] >> (x & 7)) & 1);
+  int16_t t = x;                                  // swap coordinates
+  x = y;
+  y = (int16_t)(OLED_HEIGHT - 1) - t;
+  if((y < 0) || (y >= OLED_HEIGHT) || (x < 0) || (x >= OLED_WIDTH)) return 0;
+  #endif
+  #if OLED_BANDED > 0
+  y -= OLED_bandY;                                // band relative position
+  if((uint16_t)y > 7) return 0;                   // outside of current band
+  #endif
+  return((OLED_drawbuffer[((uint16_t)y >> 3) * OLED_WIDTH + x] >> (y & 7)) & 1);
+}
+
+// Set pixel at position (x,y) inside the clip rectangle with color (unchecked)
+void OLED_putPixel(int16_t x, int16_t y, uint8_t color) {
+  #if OLED_PORTRAIT > 0
+  int16_t t = y;                                  // swap coordinates
+  y = (int16_t)(OLED_HEIGHT - 1) - x;
+  x = t;
+  #endif
+  #if OLED_BANDED > 0
+  y -= OLED_bandY;                                // band relative position
+  if((uint16_t)y > 7) return;                     // outside of current band
   #endif
+  uint8_t* ptr = &OLED_drawbuffer[((uint16_t)y >> 3) * OLED_WIDTH + x];
+  uint8_t  val = *ptr;
+  switch(color) {
+    case 0: val &= ~((uint8_t)1 << (y & 7)); break;
+    case 1: val |=  ((uint8_t)1 << (y & 7)); break;
+    case 2: val ^=  ((uint8_t)1 << (y & 7)); break;
+  }
+  if(val == *ptr) return;                         // nothing changed
+  *ptr = val;
+  OLED_markDirty((uint16_t)y >> 3, x, x);         // mark pixel as changed
 }
 
 // Set pixel at position (x,y) with color (0: clear pixel, 1: set pixel, 2: invert pixel)
 void OLED_setPixel(int16_t x, int16_t y, uint8_t color) {
-  #if OLED_PORTRAIT == 0
-  if((x < 0) || (x >= OLED_WIDTH) || (y < 0) || (y >= OLED_HEIGHT)) return;
-  switch(color) {
-    case 0: OLED_drawbuffer[((uint16_t)y >> 3) * OLED_WIDTH + x] &= ~((uint8_t)1 << (y & 7));
-            break;
-    case 1: OLED_drawbuffer[((uint16_t)y >> 3) * OLED_WIDTH + x] |=  ((uint8_t)1 << (y & 7));
-            break;
-    case 2: OLED_drawbuffer[((uint16_t)y >> 3) * OLED_WIDTH + x] ^=  ((uint8_t)1 << (y & 7));
-            break;
+  OLED_RECORD(OLED_DL_PIXEL, x, y, color, 0, 0, 0);
+  if(OLED_clipPixel(x, y)) OLED_putPixel(x, y, color);
+}
+
+// Fill span of columns (x0..x1) in one page with byte mask and color
+void OLED_fillPage(uint8_t page, uint8_t x0, uint8_t x1, uint8_t mask, uint8_t color) {
+  uint8_t* ptr = &OLED_drawbuffer[page * OLED_WIDTH + x0];
+  uint8_t  cnt = x1 - x0 + 1;
+  OLED_markDirty(page, x0, x1);
+  if(mask == 0xFF) {                              // full bytes: use 32-bit words
+    uint32_t val = color ? 0xFFFFFFFF : 0;
+    while(cnt && ((uintptr_t)ptr & 3)) {          // head bytes up to word boundary
+      if(color == 2) *ptr = ~*ptr;
+      else *ptr = val;
+      ptr++; cnt--;
+    }
+    uint32_t* wptr = (uint32_t*)ptr;
+    if(color == 2) for(; cnt>=4; cnt-=4, wptr++) *wptr = ~*wptr;
+    else           for(; cnt>=4; cnt-=4) *wptr++ = val;
+    ptr = (uint8_t*)wptr;
   }
-  #else
-  if((x < 0) || (x >= OLED_HEIGHT) || (y < 0) || (y >= OLED_WIDTH)) return;
-  x = (int16_t)(OLED_HEIGHT - 1) - x;
-  switch(color) {
-    case 0: OLED_drawbuffer[((uint16_t)x >> 3) * OLED_WIDTH + y] &= ~((uint8_t)1 << (x & 7));
-            break;
-    case 1: OLED_drawbuffer[((uint16_t)x >> 3) * OLED_WIDTH + y] |=  ((uint8_t)1 << (x & 7));
-            break;
-    case 2: OLED_drawbuffer[((uint16_t)x >> 3) * OLED_WIDTH + y] ^=  ((uint8_t)1 << (x & 7));
-            break;
+  switch(color) {                                 // partial bytes and tail
+    case 0: while(cnt--) *ptr++ &= ~mask; break;
+    case 1: while(cnt--) *ptr++ |=  mask; break;
+    case 2: while(cnt--) *ptr++ ^=  mask; break;
   }
+}
+
+// Fill rectangle (x0..x1, y0..y1) with color, clipped once, written page by page
+void OLED_fillSpan(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color) {
+  if(x0 < OLED_clipX0) x0 = OLED_clipX0;          // clip to clip rectangle
+  if(y0 < OLED_clipY0) y0 = OLED_clipY0;
+  if(x1 > OLED_clipX1) x1 = OLED_clipX1;
+  if(y1 > OLED_clipY1) y1 = OLED_clipY1;
+  if((x0 > x1) || (y0 > y1)) return;              // nothing to draw
+
+  #if OLED_PORTRAIT > 0
+  int16_t t = x0;                                 // swap coordinates
+  x0 = y0; y0 = (OLED_HEIGHT - 1) - x1;
+  x1 = y1; y1 = (OLED_HEIGHT - 1) - t;
+  #endif
+
+  #if OLED_BANDED > 0
+  y0 -= OLED_bandY; y1 -= OLED_bandY;             // clip to current band
+  if(y0 < 0) y0 = 0;
+  if(y1 > 7) y1 = 7;
+  if(y0 > y1) return;
   #endif
+
+  uint8_t page0 = y0 >> 3, page1 = y1 >> 3;
+  uint8_t head  = 0xFF << (y0 & 7);               // mask of first page
+  uint8_t tail  = 0xFF >> (7 - (y1 & 7));         // mask of last page
+  if(page0 == page1) {
+    OLED_fillPage(page0, x0, x1, head & tail, color);
+    return;
+  }
+  OLED_fillPage(page0, x0, x1, head, color);
+  while(++page0 < page1) OLED_fillPage(page0, x0, x1, 0xFF, color);
+  OLED_fillPage(page1, x0, x1, tail, color);
+}
+
+// Write column of (n) pixels (max. 32) from bits (LSB on top) at position (x,y)
+// repeated (w) times to the right directly into the buffer (landscape mode only)
+#if OLED_PORTRAIT == 0
+void OLED_writeColumn(int16_t x, int16_t y, uint8_t w, uint32_t bits, uint8_t n) {
+  int16_t x1 = x + w - 1;                         // clip to clip rectangle
+  int16_t ya = y, yb = y + n - 1;
+  if(x  < OLED_clipX0) x  = OLED_clipX0;
+  if(x1 > OLED_clipX1) x1 = OLED_clipX1;
+  if(ya < OLED_clipY0) ya = OLED_clipY0;
+  if(yb > OLED_clipY1) yb = OLED_clipY1;
+  #if OLED_BANDED > 0
+  y -= OLED_bandY; ya -= OLED_bandY; yb -= OLED_bandY; // clip to current band
+  if(ya < 0) ya = 0;
+  if(yb > 7) yb = 7;
+  #endif
+  if((x > x1) || (ya > yb)) return;
+  bits >>= ya - y;                                // skip clipped pixels at the top
+  n = yb - ya + 1;
+  uint8_t  page  = ya >> 3;
+  uint8_t  shift = ya & 7;
+  uint8_t* ptr   = &OLED_drawbuffer[page * OLED_WIDTH + x];
+  w = x1 - x + 1;
+  while(n) {
+    uint8_t cnt  = 8 - shift;                     // pixels in this page
+    if(cnt > n) cnt = n;
+    uint8_t mask = ((1 << cnt) - 1) << shift;
+    uint8_t val  = ((uint8_t)bits << shift) & mask;
+    for(uint8_t i=0; i<w; i++) ptr[i] = (ptr[i] & ~mask) | val;
+    OLED_markDirty(page++, x, x1);
+    bits >>= cnt; n -= cnt; shift = 0;
+    ptr += OLED_WIDTH;
+  }
 }
+#endif
 
 // Draw vertical line starting from (x,y), height (h), color (0: cleared, 1: set)
 void OLED_drawVLine(int16_t x, int16_t y, int16_t h, uint8_t color) {
-  for(int16_t i=y; i<y+h; i++) OLED_setPixel(x, i, color);
+  OLED_RECORD(OLED_DL_VLINE, x, y, h, color, 0, 0);
+  OLED_fillSpan(x, y, x, y + h - 1, color);
 }
 
 // Draw horizontal line starting from (x,y), width (w), color (0: cleared, 1: set)
 void OLED_drawHLine(int16_t x, int16_t y, int16_t w, uint8_t color) {
-  for(int16_t i=x; i<x+w; i++) OLED_setPixel(i, y, color);
+  OLED_RECORD(OLED_DL_HLINE, x, y, w, color, 0, 0);
+  OLED_fillSpan(x, y, x + w - 1, y, color);
 }
 
 // Draw line from position (x0,y0) to (x1,y1) with color (0: cleared, 1: set)
-// (Bresenham's line algorithm)
+// (Bresenham's line algorithm, pixels with the same minor coordinate are drawn as runs)
 void OLED_drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color) {
+  OLED_RECORD(OLED_DL_LINE, x0, y0, x1, y1, color, 0);
+  int16_t xa = (x0 < x1) ? x0 : x1, xb = x0 + x1 - xa; // bounding box
+  int16_t ya = (y0 < y1) ? y0 : y1, yb = y0 + y1 - ya;
+  if(OLED_clipOutside(xa, ya, xb, yb)) return;
+  if((x0 == x1) || (y0 == y1)) {                  // axis-aligned line: one span
+    OLED_fillSpan(xa, ya, xb, yb, color);
+    return;
+  }
+  uint8_t check = !OLED_clipInside(xa, ya, xb, yb); // check pixels only if necessary
   int16_t dx = OLED_abs(x1 - x0);
   int16_t sx = x0 < x1 ? 1 : -1;
   int16_t dy = -OLED_abs(y1 - y0);
   int16_t sy = y0 < y1 ? 1 : -1;
   int16_t error = dx + dy;
-    
+  uint8_t steep = (-dy > dx);                     // runs are vertical
+  int16_t rx = x0, ry = y0;                       // start of current run
+  int16_t px, py;                                 // current pixel
+
+  // Draw run from (rx,ry) to (px,py), single pixels directly, longer runs as span
+  #define OLED_drawRun() \
+    if((rx == px) && (ry == py)) { \
+      if(!check || OLED_clipPixel(px, py)) OLED_putPixel(px, py, color); \
+    } \
+    else if(steep) OLED_fillSpan(px, (ry < py) ? ry : py, px, (ry < py) ? py : ry, color); \
+    else           OLED_fillSpan((rx < px) ? rx : px, py, (rx < px) ? px : rx, py, color)
+
   while(1) {
-    OLED_setPixel(x0, y0, color);
+    px = x0; py = y0;
     if(x0 == x1 && y0 == y1) break;
     int16_t e2 = error * 2;
     if(e2 >= dy) {
@@ -343,11 +823,18 @@ void OLED_drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color
       error += dx;
       y0 += sy;
     }
+    if(steep ? (x0 != px) : (y0 != py)) {         // run ends?
+      OLED_drawRun();
+      rx = x0; ry = y0;
+    }
   }
+  OLED_drawRun();                                 // last run
+  #undef OLED_drawRun
 }
 
 // Draw rectangle starting from (x,y), width (w), height (h), color (0: cleared, 1: set)
 void OLED_drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
+  OLED_RECORD(OLED_DL_RECT, x, y, w, h, color, 0);
   OLED_drawHLine(x    , y,     w, color);
   OLED_drawHLine(x    , y+h-1, w, color);
   OLED_drawVLine(x    , y,     h, color);
@@ -356,12 +843,17 @@ void OLED_drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
 
 // Draw filled rectangle starting from (x,y), width (w), height (h), color
 void OLED_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
-  for(int16_t i=x; i<x+w; i++) OLED_drawVLine(i, y, h, color);
+  OLED_RECORD(OLED_DL_FILLRECT, x, y, w, h, color, 0);
+  OLED_fillSpan(x, y, x + w - 1, y + h - 1, color);
 }
 
 // Draw circle, center at position (x0,y0), radius (r), color (0: cleared, 1: set)
 // (midpoint circle algorithm)
 void OLED_drawCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
+  OLED_RECORD(OLED_DL_CIRCLE, x0, y0, r, color, 0, 0);
+  if(OLED_clipOutside(x0 - r, y0 - r, x0 + r, y0 + r)) return;
+  uint8_t check = !OLED_clipInside(x0 - r, y0 - r, x0 + r, y0 + r); // check pixels only if necessary
+  #define OLED_plot(x, y) if(!check || OLED_clipPixel(x, y)) OLED_putPixel(x, y, color)
   int16_t f = 1 - r;
   int16_t ddF_x = 1;
   int16_t ddF_y = -(r << 1);
@@ -369,14 +861,15 @@ void OLED_drawCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
   int16_t y = r;
 
   while(x <= y) {
-    OLED_setPixel(x0 + x, y0 + y, color);
-    OLED_setPixel(x0 - x, y0 + y, color);
-    OLED_setPixel(x0 + x, y0 - y, color);
-    OLED_setPixel(x0 - x, y0 - y, color);
-    OLED_setPixel(x0 + y, y0 + x, color);
-    OLED_setPixel(x0 - y, y0 + x, color);
-    OLED_setPixel(x0 + y, y0 - x, color);
-    OLED_setPixel(x0 - y, y0 - x, color);
+    OLED_plot(x0 + x, y0 + y);
+    OLED_plot(x0 - x, y0 + y);
+    OLED_plot(x0 + x, y0 - y);
+    OLED_plot(x0 - x, y0 - y);
+    OLED_plot(x0 + y, y0 + x);
+    OLED_plot(x0 - y, y0 + x);
+    OLED_plot(x0 + y, y0 - x);
+    OLED_plot(x0 - y, y0 - x);
+    #undef OLED_plot
 
     if(f >= 0) {
       y--;
@@ -390,21 +883,29 @@ void OLED_drawCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
 }
 
 // Draw filled circle, center at position (x0,y0), radius (r), color
-// (midpoint circle algorithm)
+// (midpoint circle algorithm, each column is filled once by the span kernel)
 void OLED_fillCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
+  OLED_RECORD(OLED_DL_FILLCIRCLE, x0, y0, r, color, 0, 0);
+  if((r < 0) || OLED_clipOutside(x0 - r, y0 - r, x0 + r, y0 + r)) return;
   int16_t f = 1 - r;
   int16_t ddF_x = 1;
   int16_t ddF_y = -(r << 1);
   int16_t x = 0;
   int16_t y = r;
+  int16_t rx = 0;                                 // first column of inner block
 
   while(x <= y) {
-    OLED_drawVLine(x0 - x, y0 - y, (y << 1) + 1, color);
-    OLED_drawVLine(x0 + x, y0 - y, (y << 1) + 1, color);
-    OLED_drawVLine(x0 - y, y0 - x, (x << 1) + 1, color);
-    OLED_drawVLine(x0 + y, y0 - x, (x << 1) + 1, color);
-
-    if(f >= 0) {
+    if(f >= 0) {                                  // height changes after this column:
+      if(rx) {                                    // -> fill inner block of same height
+        OLED_fillSpan(x0 + rx, y0 - y, x0 + x,  y0 + y, color);
+        OLED_fillSpan(x0 - x,  y0 - y, x0 - rx, y0 + y, color);
+      }
+      else OLED_fillSpan(x0 - x, y0 - y, x0 + x, y0 + y, color);
+      rx = x + 1;
+      if(y > x) {                                 // -> fill outer columns
+        OLED_fillSpan(x0 - y, y0 - x, x0 - y, y0 + x, color);
+        OLED_fillSpan(x0 + y, y0 - x, x0 + y, y0 + x, color);
+      }
       y--;
       ddF_y += 2;
       f += ddF_y;
@@ -413,6 +914,13 @@ void OLED_fillCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
     ddF_x += 2;
     f += ddF_x;
   }
+  if(rx < x) {                                    // remaining inner block
+    if(rx) {
+      OLED_fillSpan(x0 + rx,    y0 - y, x0 + x - 1,  y0 + y, color);
+      OLED_fillSpan(x0 - x + 1, y0 - y, x0 - rx,     y0 + y, color);
+    }
+    else OLED_fillSpan(x0 - x + 1, y0 - y, x0 + x - 1, y0 + y, color);
+  }
 }
 
 // ===================================================================================
@@ -421,34 +929,98 @@ void OLED_fillCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
 
 // Draw a complete screen
 void OLED_drawScreen(const uint8_t* bmp) {
+  OLED_RECORD(OLED_DL_SCREEN, 0, 0, 0, 0, 0, bmp);
+  #if OLED_BANDED > 0
+  bmp += (OLED_bandY >> 3) * OLED_WIDTH;          // copy current band only
+  #endif
   uint32_t* ptr1 = (uint32_t*)bmp;
   uint32_t* ptr2 = (uint32_t*)OLED_buffer;
   uint32_t  cnt = sizeof(OLED_buffer) >> 2;
   while(cnt--) *ptr2++ = *ptr1++;
+  OLED_segInvalidate();
+  OLED_markAll();
 }
 
-// Draw bitmap at position (x0,y0), width (w), hight (h), pointer to bitmap (*bmp)
-void OLED_drawBitmap(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp) {
-  for(int16_t y=y0; y<y0+h; y+=8) {
-    for(int16_t x=x0; x<x0+w; x++) {
-      uint8_t line = *bmp++;
-      for(int16_t i=y; i<y+8; i++, line>>=1) {
-        OLED_setPixel(x, i, line & 1);
-      }
+// Blit one page of bitmap bytes (shifted left or right) into the screen buffer
+void OLED_blitPage(int16_t page, uint8_t x, const uint8_t* src, uint8_t cnt,
+                   int8_t shift, uint8_t mode) {
+  int16_t ya = OLED_clipY0 - (page << 3);         // clip rows to clip rectangle
+  int16_t yb = OLED_clipY1 - (page << 3);
+  if((ya > 7) || (yb < 0)) return;
+  uint8_t mask = (shift >= 0) ? (0xFF << shift) : (0xFF >> -shift);
+  if(ya > 0) mask &= 0xFF << ya;
+  if(yb < 7) mask &= 0xFF >> (7 - yb);
+  #if OLED_BANDED > 0
+  if(page != (OLED_bandY >> 3)) return;           // outside of current band
+  page = 0;
+  #endif
+  uint8_t* dst  = &OLED_drawbuffer[page * OLED_WIDTH + x];
+  OLED_markDirty(page, x, x + cnt - 1);
+
+  // Page-aligned opaque bitmap: plain byte copy
+  if(!shift && (mask == 0xFF) && (mode == OLED_BLIT_OPAQUE)) {
+    while(cnt--) *dst++ = *src++;
+    return;
+  }
+
+  // Unaligned: shift, mask and combine
+  while(cnt--) {
+    uint8_t val = ((shift >= 0) ? (*src++ << shift) : (*src++ >> -shift)) & mask;
+    switch(mode) {
+      case OLED_BLIT_OPAQUE: *dst = (*dst & ~mask) | val; break;
+      case OLED_BLIT_SPRITE: *dst |= val; break;
+      case OLED_BLIT_XOR:    *dst ^= val; break;
     }
+    dst++;
   }
 }
 
-// Draw sprite (bitmap with transparent background)
-void OLED_drawSprite(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp) {
-  for(int16_t y=y0; y<y0+h; y+=8) {
+// Blit bitmap at position (x0,y0), width (w), hight (h) with mode, clipped once.
+// Each bitmap row of 8 pixels is written into one or, if not page-aligned, two pages.
+void OLED_blit(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp, uint8_t mode) {
+  #if OLED_PORTRAIT > 0
+  for(int16_t y=y0; y<y0+h; y+=8) {               // portrait: pixel by pixel
     for(int16_t x=x0; x<x0+w; x++) {
       uint8_t line = *bmp++;
       for(int16_t i=y; i<y+8; i++, line>>=1) {
-        if(line & 1) OLED_setPixel(x, i, 1);
+        if(mode == OLED_BLIT_OPAQUE) OLED_setPixel(x, i, line & 1);
+        else if(line & 1) OLED_setPixel(x, i, (mode == OLED_BLIT_XOR) ? 2 : 1);
       }
     }
   }
+  #else
+  int16_t xa = x0, xb = x0 + w - 1;               // clip columns
+  if(xa < OLED_clipX0) xa = OLED_clipX0;
+  if(xb > OLED_clipX1) xb = OLED_clipX1;
+  if(xa > xb) return;
+  uint8_t cnt   = xb - xa + 1;
+  int8_t  shift = y0 & 7;                         // bit offset within page
+  int16_t page  = (y0 - shift) / 8;               // first page (rounded down)
+  bmp += xa - x0;                                 // skip clipped columns
+  for(int16_t y=y0; y<y0+h; y+=8, page++, bmp+=w) {
+    if(y > OLED_clipY1) return;                   // below clip rectangle
+    OLED_blitPage(page, xa, bmp, cnt, shift, mode);
+    if(shift) OLED_blitPage(page + 1, xa, bmp, cnt, shift - 8, mode);
+  }
+  #endif
+}
+
+// Draw bitmap at position (x0,y0), width (w), hight (h), pointer to bitmap (*bmp)
+void OLED_drawBitmap(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp) {
+  OLED_RECORD(OLED_DL_BITMAP, x0, y0, w, h, 0, bmp);
+  OLED_blit(x0, y0, w, h, bmp, OLED_BLIT_OPAQUE);
+}
+
+// Draw sprite (bitmap with transparent background)
+void OLED_drawSprite(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp) {
+  OLED_RECORD(OLED_DL_SPRITE, x0, y0, w, h, 0, bmp);
+  OLED_blit(x0, y0, w, h, bmp, OLED_BLIT_SPRITE);
+}
+
+// Draw bitmap inverting the screen where its pixels are set
+void OLED_drawBitmapXOR(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp) {
+  OLED_RECORD(OLED_DL_BITMAPXOR, x0, y0, w, h, 0, bmp);
+  OLED_blit(x0, y0, w, h, bmp, OLED_BLIT_XOR);
 }
 
 // ===================================================================================
@@ -459,6 +1031,25 @@ void OLED_drawSprite(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t
 int16_t OLED_cx, OLED_cy;                           // cursor position
 uint8_t OLED_ci, OLED_cs = 1;                       // inversion and size
 
+// Lookup table to scale a nibble of a font column by the text size
+#if OLED_PORTRAIT == 0
+uint32_t OLED_scaleLUT[16];
+uint8_t  OLED_scaleSize;                            // text size of lookup table
+
+// Build lookup table for current text size (bit abcd -> aa..bb..cc..dd..)
+void OLED_scaleBuild(void) {
+  for(uint8_t n=0; n<16; n++) {
+    uint32_t val = 0;
+    for(uint8_t i=4; i; i--) {
+      val <<= OLED_cs;
+      if(n & (1 << (i - 1))) val |= ((uint32_t)1 << OLED_cs) - 1;
+    }
+    OLED_scaleLUT[n] = val;
+  }
+  OLED_scaleSize = OLED_cs;
+}
+#endif
+
 // Set cursor position
 void OLED_cursor(int16_t x, int16_t y) {
   OLED_cx = x; OLED_cy = y;
@@ -482,15 +1073,67 @@ uint16_t OLED_stretch(uint16_t x) {
   return x | x<<1;
 }
 
+#if OLED_BANDED > 0
+// Record character, append it to the last text record if possible
+void OLED_recordChar(char c) {
+  uint8_t* p = OLED_dl + OLED_dlText;
+  int16_t  x = OLED_cx;
+  if(OLED_cs <= 8) OLED_cx += OLED_cs * 6;        // advance cursor
+  else if(OLED_cs == OLED_SMOOTH) OLED_cx += 12;
+  else OLED_cx += 6;
+  if( OLED_dlLen && (p[0] == OLED_DL_TEXT) && (OLED_dlLen == OLED_dlText + 8 + p[7])
+   && (OLED_dlTextEnd == x)
+   && (p[3] == (uint8_t)OLED_cy) && (p[4] == (uint8_t)(OLED_cy >> 8))
+   && (p[5] == OLED_cs) && (p[6] == OLED_ci) && (p[7] < 255) && (OLED_dlLen < OLED_DL_SIZE)) {
+    p[7]++;                                       // character follows last record:
+    OLED_dl[OLED_dlLen++] = c;                    // -> append it
+    OLED_dlTextEnd = OLED_cx;
+    return;
+  }
+  if(OLED_dlLen + 9 > OLED_DL_SIZE) {             // no space left?
+    OLED_dlFull = 1;                              // -> set overflow flag
+    return;
+  }
+  OLED_dlText = OLED_dlLen;                       // new text record:
+  p = OLED_dl + OLED_dlLen;
+  *p++ = OLED_DL_TEXT;
+  *p++ = x;       *p++ = x >> 8;                  // position
+  *p++ = OLED_cy; *p++ = OLED_cy >> 8;
+  *p++ = OLED_cs; *p++ = OLED_ci;                 // style
+  *p++ = 1;       *p++ = c;                       // length and character
+  OLED_dlLen += 9;
+  OLED_dlTextEnd = OLED_cx;
+}
+#endif
+
 // Write a character
 void OLED_write(char c) {
   c &= 0x7f;
   if(c >= 32) {
+    #if OLED_BANDED > 0
+    if(!OLED_replaying) {
+      OLED_recordChar(c);
+      return;
+    }
+    #endif
     uint16_t ptr = c - 32;
     ptr += ptr << 2;
 
     // Standard character, if necessary enlarged
     if(OLED_cs <= 8) {
+      #if OLED_PORTRAIT == 0
+      uint8_t h = OLED_cs << 2;                   // pixels per scaled nibble
+      if(OLED_scaleSize != OLED_cs) OLED_scaleBuild();
+      for(uint8_t i=6; i; i--) {                  // scale columns via lookup table
+        uint8_t line = (i == 1) ? 0 : OLED_FONT[ptr++];
+        if(OLED_ci) line = ~line;
+        uint32_t lo = OLED_scaleLUT[line & 0x0F];
+        uint32_t hi = OLED_scaleLUT[line >> 4];
+        OLED_writeColumn(OLED_cx, OLED_cy,     OLED_cs, lo, h);
+        OLED_writeColumn(OLED_cx, OLED_cy + h, OLED_cs, hi, h);
+        OLED_cx += OLED_cs;
+      }
+      #else
       for(uint8_t i=6; i; i--) {
         uint8_t line, col;
         int16_t y1 = OLED_cy;
@@ -507,10 +1150,22 @@ void OLED_write(char c) {
         }
         OLED_cx += OLED_cs;
       }
+      #endif
+      return;
+    }
+
+    // Double-sized, smoothed character (12x16, precomputed glyph)
+    #if OLED_SMOOTH_TABLE > 0
+    if(OLED_cs == OLED_SMOOTH) {
+      OLED_blit(OLED_cx, OLED_cy, 10, 16, &OLED_FONT_SMOOTH[(uint16_t)(c - 32) * 20], OLED_BLIT_OPAQUE);
+      OLED_fillRect(OLED_cx + 10, OLED_cy, 2, 16, 0); // space between characters
+      if(OLED_ci) OLED_fillRect(OLED_cx, OLED_cy, 12, 16, 2); // invert character
+      OLED_cx += 12;
       return;
     }
 
     // Double-sized, smoothed character (10x16, David Johnson-Davies' Smooth Big Text algorithm)
+    #else
     if(OLED_cs == OLED_SMOOTH) {
       uint16_t col0L, col0R, col1L, col1R;
       uint8_t col0 = OLED_FONT[ptr++];
@@ -529,32 +1184,42 @@ void OLED_write(char c) {
             }
           }
         }
-        int16_t y1 = OLED_cy;
         if(OLED_ci) {
           col0L = ~col0L;
           col0R = ~col0R;
         }
+        #if OLED_PORTRAIT == 0
+        OLED_writeColumn(OLED_cx,     OLED_cy, 1, col0L, 16);
+        OLED_writeColumn(OLED_cx + 1, OLED_cy, 1, col0R, 16);
+        #else
+        int16_t y1 = OLED_cy;
         for(int8_t i=16; i; i--, col0L>>=1, col0R>>=1) {
           OLED_setPixel(OLED_cx,   y1,   col0L & 1);
           OLED_setPixel(OLED_cx+1, y1++, col0R & 1);
         }
+        #endif
         col0 = col1; col0L = col1L; col0R = col1R; OLED_cx += 2;
       }
       OLED_fillRect(OLED_cx, OLED_cy, 2, 16, OLED_ci);
       OLED_cx += 2;
       return;
     }
+    #endif
 
     // V-stretched character (5x16)
     for(uint8_t col=6; col; col--) {
       uint8_t col0 = OLED_FONT[ptr++];
       if(col == 1) col0 = 0;
       if(OLED_ci) col0 = ~col0;
+      #if OLED_PORTRAIT == 0
+      OLED_writeColumn(OLED_cx, OLED_cy, 1, OLED_stretch(col0), 16);
+      #else
       int16_t y1 = OLED_cy;
       for(uint8_t i=8; i; i--, col0>>=1) {
         OLED_setPixel(OLED_cx, y1++, col0 & 1);
         OLED_setPixel(OLED_cx, y1++, col0 & 1);
       }
+      #endif
       OLED_cx++;
     }
     return;
@@ -581,7 +1246,42 @@ void OLED_print(char* str) {
 // OLED 7-Segment Functions
 // ===================================================================================
 
-// Print value as 7-segment digits (BCD conversion by substraction method)
+// Remembered 7-segment cells (position and drawn value + 1, 0: empty)
+#if OLED_SEG_FONT > 0
+typedef struct { int16_t x, y; uint8_t val; } OLED_SEGCELL_t;
+OLED_SEGCELL_t OLED_segCache[OLED_SEG_CACHE];
+uint8_t OLED_segNext;                             // next cache entry to replace
+enum{ OLED_SEG_BLANK = 10, OLED_SEG_POINT };      // values besides digits
+#endif
+
+// Forget all drawn 7-segment cells
+void OLED_segInvalidate(void) {
+  #if OLED_SEG_FONT > 0
+  for(uint8_t i=0; i<OLED_SEG_CACHE; i++) OLED_segCache[i].val = 0;
+  #endif
+}
+
+// Check if cell at cursor shows value already, otherwise remember it
+#if OLED_SEG_FONT > 0
+uint8_t OLED_segCached(uint8_t val) {
+  OLED_SEGCELL_t* cell = OLED_segCache;
+  val++;
+  for(uint8_t i=0; i<OLED_SEG_CACHE; i++, cell++) {
+    if(cell->val && (cell->x == OLED_cx) && (cell->y == OLED_cy)) {
+      if(cell->val == val) return 1;              // cell is unchanged
+      cell->val = val;                            // cell must be redrawn
+      return 0;
+    }
+  }
+  cell = &OLED_segCache[OLED_segNext];            // new cell:
+  if(++OLED_segNext >= OLED_SEG_CACHE) OLED_segNext = 0;
+  cell->x = OLED_cx; cell->y = OLED_cy; cell->val = val;
+  return 0;
+}
+#endif
+
+// Print value as 7-segment digits (BCD conversion by substraction method).
+// Only cells which have changed since the last call are drawn.
 void OLED_printSegment(uint16_t value, uint8_t digits, uint8_t lead, uint8_t decimal) {
   static const uint16_t DIVIDER[] = {1, 10, 100, 1000, 10000};
   uint8_t leadflag = 0;                           // flag for leading spaces
@@ -594,20 +1294,31 @@ void OLED_printSegment(uint16_t value, uint8_t digits, uint8_t lead, uint8_t dec
       value -= divider;                           // decrease value by divider
     }
     if(digits == decimal) leadflag++;             // end leading characters before decimal
-    if(leadflag || !lead) {
-      #if OLED_SEG_FONT == 0
-      OLED_write(digitval + '0');
-      #elif OLED_SEG_FONT == 1
-      uint16_t ptr = (uint16_t)digitval;          // character pointer
-      ptr = (ptr << 5) + (ptr << 4) + (ptr << 2); // -> ptr = c * 13 * 4;
-      OLED_drawBitmap(OLED_cx, OLED_cy, 13, 32, (uint8_t*)&OLED_FONT_SEG[ptr]);
-      #elif OLED_SEG_FONT == 2
-      uint16_t ptr = (uint16_t)digitval;          // character pointer
-      ptr = (ptr << 3) + (ptr << 1);              // -> ptr = c * 5 * 2;
-      OLED_drawBitmap(OLED_cx, OLED_cy, 5, 16, (uint8_t*)&OLED_FONT_SEG[ptr]);
-      #endif
+    #if OLED_SEG_FONT > 0
+    if(!(leadflag || !lead)) digitval = OLED_SEG_BLANK;
+    if(!OLED_segCached(digitval)) {               // cell has changed?
+      if(digitval == OLED_SEG_BLANK) {            // -> clear blank cell
+        #if OLED_SEG_FONT == 1
+        OLED_fillRect(OLED_cx, OLED_cy, 13, 32, 0);
+        #else
+        OLED_fillRect(OLED_cx, OLED_cy,  5, 16, 0);
+        #endif
+      }
+      else {                                      // -> draw digit
+        #if OLED_SEG_FONT == 1
+        uint16_t ptr = (uint16_t)digitval;        // character pointer
+        ptr = (ptr << 5) + (ptr << 4) + (ptr << 2); // -> ptr = c * 13 * 4;
+        OLED_drawBitmap(OLED_cx, OLED_cy, 13, 32, &OLED_FONT_SEG[ptr]);
+        #else
+        uint16_t ptr = (uint16_t)digitval;        // character pointer
+        ptr = (ptr << 3) + (ptr << 1);            // -> ptr = c * 5 * 2;
+        OLED_drawBitmap(OLED_cx, OLED_cy, 5, 16, &OLED_FONT_SEG[ptr]);
+        #endif
+      }
     }
+    #endif
     #if OLED_SEG_FONT == 0
+    if(leadflag || !lead) OLED_write(digitval + '0');
     else OLED_write(' ');
     #elif OLED_SEG_FONT == 1
     OLED_cx += OLED_SEG_SPACE + 13;
@@ -617,13 +1328,83 @@ void OLED_printSegment(uint16_t value, uint8_t digits, uint8_t lead, uint8_t dec
     if(decimal && (digits == decimal)) {
       #if OLED_SEG_FONT == 0
       OLED_write('.');
-      #elif OLED_SEG_FONT == 1
-      OLED_fillRect(OLED_cx, OLED_cy + 28, 3, 3, 1);  // print decimal point
+      #else
+      if(!OLED_segCached(OLED_SEG_POINT)) {       // print decimal point
+        #if OLED_SEG_FONT == 1
+        OLED_fillRect(OLED_cx, OLED_cy + 28, 3, 3, 1);
+        #else
+        OLED_fillRect(OLED_cx, OLED_cy + 12, 2, 2, 1);
+        #endif
+      }
+      #endif
+      #if OLED_SEG_FONT == 1
       OLED_cx += OLED_SEG_SPACE + 3;
       #elif OLED_SEG_FONT == 2
-      OLED_fillRect(OLED_cx, OLED_cy + 12, 2, 2, 1);  // print decimal point
       OLED_cx += OLED_SEG_SPACE + 2;
       #endif
     }
   }
 }
+
+// ===================================================================================
+// OLED Display List Replay (banded mode)
+// ===================================================================================
+#if OLED_BANDED > 0
+
+// Render all records of the display list into the current band
+void OLED_replay(void) {
+  int16_t  cx = OLED_cx, cy = OLED_cy;            // save text state
+  uint8_t  cs = OLED_cs, ci = OLED_ci;
+  int16_t  clip[4] = { OLED_clipX0, OLED_clipY0, OLED_clipX1, OLED_clipY1 };
+  uint8_t* p  = OLED_dl;
+  uint8_t* end = OLED_dl + OLED_dlLen;
+  OLED_replaying = 1;
+  OLED_unclip();                                  // clip is part of the display list
+  while(p < end) {
+    uint8_t op = *p++;
+
+    // Text record
+    if(op == OLED_DL_TEXT) {
+      OLED_cx = (int16_t)(p[0] | (p[1] << 8));
+      OLED_cy = (int16_t)(p[2] | (p[3] << 8));
+      OLED_cs = p[4]; OLED_ci = p[5];
+      uint8_t len = p[6];
+      p += 7;
+      while(len--) OLED_write(*p++);
+      continue;
+    }
+
+    // Drawing function record
+    int16_t a[5];
+    const uint8_t* bmp = 0;
+    for(uint8_t i=0; i<OLED_DL_ARGS[op]; i++, p+=2) a[i] = (int16_t)(p[0] | (p[1] << 8));
+    if(op >= OLED_DL_SCREEN) {
+      uintptr_t addr = 0;
+      for(uint8_t i=sizeof(bmp); i; i--) addr = (addr << 8) | p[i-1];
+      bmp = (const uint8_t*)addr;
+      p += sizeof(bmp);
+    }
+    switch(op) {
+      case OLED_DL_PIXEL:      OLED_setPixel(a[0], a[1], a[2]); break;
+      case OLED_DL_VLINE:      OLED_drawVLine(a[0], a[1], a[2], a[3]); break;
+      case OLED_DL_HLINE:      OLED_drawHLine(a[0], a[1], a[2], a[3]); break;
+      case OLED_DL_LINE:       OLED_drawLine(a[0], a[1], a[2], a[3], a[4]); break;
+      case OLED_DL_RECT:       OLED_drawRect(a[0], a[1], a[2], a[3], a[4]); break;
+      case OLED_DL_FILLRECT:   OLED_fillRect(a[0], a[1], a[2], a[3], a[4]); break;
+      case OLED_DL_CIRCLE:     OLED_drawCircle(a[0], a[1], a[2], a[3]); break;
+      case OLED_DL_FILLCIRCLE: OLED_fillCircle(a[0], a[1], a[2], a[3]); break;
+      case OLED_DL_CLIP:       OLED_clip(a[0], a[1], a[2], a[3]); break;
+      case OLED_DL_SCREEN:     OLED_drawScreen(bmp); break;
+      case OLED_DL_BITMAP:     OLED_drawBitmap(a[0], a[1], a[2], a[3], bmp); break;
+      case OLED_DL_SPRITE:     OLED_drawSprite(a[0], a[1], a[2], a[3], bmp); break;
+      case OLED_DL_BITMAPXOR:  OLED_drawBitmapXOR(a[0], a[1], a[2], a[3], bmp); break;
+    }
+  }
+  OLED_replaying = 0;
+  OLED_cx = cx; OLED_cy = cy;                     // restore text state
+  OLED_cs = cs; OLED_ci = ci;
+  OLED_clipX0 = clip[0]; OLED_clipY0 = clip[1];   // restore clip rectangle
+  OLED_clipX1 = clip[2]; OLED_clipY1 = clip[3];
+}
+
+#endif
@@ -1,5 +1,5 @@
 // ===================================================================================
-// SSD1306/SH1106 I2C OLED Graphics Functions                                 * v1.6 *
+// SSD1306/SH1106 I2C OLED Graphics Functions                                 * v1.7 *
 // ===================================================================================
 //
 // Functions available:
@@ -10,13 +10,17 @@
 // OLED_invert(v)                 Invert display (0: inverse off, 1: inverse on)
 // OLED_flip(xflip,yflip)         Flip display (0: flip off, 1: flip on)
 // OLED_vscroll(y)                Scroll display vertically
-// OLED_refresh()                 Refresh (flush) screen buffer (send buffer via I2C)
+// OLED_refresh()                 Refresh (flush) screen buffer (send changed areas via I2C)
+// OLED_invalidate()              Mark complete screen as changed (display content unknown)
+// OLED_busy()                    Check if screen buffer is still being sent
 // OLED_flush()                   Refresh (flush) screen buffer (alias)
 //
 // OLED_clear()                   Clear OLED screen buffer
 // OLED_copy()                    Copy OLED screen buffer (for double-buffer mode)
 // OLED_getPixel(x,y)             Get pixel color at (x,y) (0: pixel cleared, 1: pixel set)
 // OLED_setPixel(x,y,c)           Set pixel color (c) at position (x,y)
+// OLED_clip(x,y,w,h)             Set clip rectangle starting from (x,y), width (w), height (h)
+// OLED_unclip()                  Reset clip rectangle to complete screen
 //
 // OLED_drawVLine(x,y,h,c)        Draw vertical line starting from (x,y), height (h), color (c)
 // OLED_drawHLine(x,y,w,c)        Draw horizontal line starting from (x,y), width (w), color (c)
@@ -30,6 +34,7 @@
 // OLED_drawScreen(*p)            Draw complete screen, pointer to bitmap (*p)
 // OLED_drawBitmap(x,y,w,h,*p)    Draw bitmap at (x,y), width (w), hight (h), pointer to bitmap (*p)
 // OLED_drawSprite(x,y,w,h,*p)    Draw sprite at (x,y), width (w), hight (h), pointer to bitmap (*p)
+// OLED_drawBitmapXOR(x,y,w,h,*p) Draw bitmap at (x,y), width (w), hight (h), inverting set pixels
 //
 // OLED_cursor(x,y)               Set text cursor at position (x,y)
 // OLED_textsize(sz)              Set text size (sz)
@@ -39,6 +44,7 @@
 // OLED_printSegment(v,d,l,dp)    Print value (v) at cursor position using defined segment font
 //                                with (d) number of digits, (l) leading (0: '0', 1: space) and 
 //                                decimal point at position (dp) counted from the right
+// OLED_segInvalidate()           Forget the drawn 7-segment digits (redraw all with next print)
 //
 // If print functions are activated (see below, print.h must be included):
 // -----------------------------------------------------------------------
@@ -57,6 +63,35 @@
 // - color: 0: clear pixel (black), 1: set pixel (white), 2: invert pixel
 // - size:  1: normal 6x8 pixels, 2: double size (12x16), ... , 8: 8 times (48x64)
 //          9: smoothed double size (12x16), 10: v-stretched (6x16)
+// - Drawing functions track the changed column span of each page. OLED_refresh() only
+//   sends these spans (SSD1306: within one column/page window, SH1106: one transaction
+//   per page, page/column commands precede the data). Call OLED_invalidate() after
+//   writing to OLED_buffer[] directly.
+// - OLED_sentBytes holds the number of screen data bytes of the last refresh.
+// - Drawing functions only draw inside the clip rectangle set by OLED_clip(). They
+//   intersect their bounding box with it once, OLED_clear() and OLED_drawScreen()
+//   ignore it.
+// - Banded mode (OLED_BANDED 1) replaces the screen buffer by a display list of
+//   OLED_DL_SIZE bytes and a buffer for one page (saves about 500 bytes of RAM).
+//   Drawing functions are only recorded, OLED_refresh() renders and sends the screen
+//   page by page (blocking until the last page is queued, always the full screen).
+//   OLED_clear() empties the display list, OLED_dlFull is set when it overflows.
+//   OLED_getPixel() is not available and double buffering can't be used.
+// - With OLED_PAGE_HASH 1, OLED_refresh() keeps a 16-bit checksum (CRC-16) of each
+//   page shown on the display and doesn't send changed pages with the same checksum
+//   again (e.g. after OLED_clear() and redrawing the same content, or unchanged bands
+//   in banded mode). OLED_pagesSent and OLED_pagesSkipped count the pages.
+//   OLED_invalidate() forgets the checksums, call it if the display lost its content.
+// - OLED_printSegment() remembers the digit drawn in each cell (cursor position) and
+//   only redraws changed cells, blank cells are cleared. OLED_clear() forgets them,
+//   call OLED_segInvalidate() after drawing over the digits otherwise.
+// - OLED_refresh() queues the screen data as I2C transactions, it is sent via DMA in
+//   the background. Without double buffer, the screen buffer must not be changed
+//   before the transfer is completed (check with OLED_busy()). OLED_clear() waits
+//   for this automatically. Pages which couldn't be queued in interrupt context
+//   (queue full) are queued by OLED_busy(), so poll it until the refresh is done.
+// - With double buffer, OLED_refresh() copies the changed spans into the new draw
+//   buffer, so it holds the frame just sent, like after OLED_copy().
 //
 // Tested devices:
 // ---------------
@@ -88,7 +123,9 @@ extern "C" {
 #define OLED_ADDR         0x3C      // OLED I2C device address
 #define OLED_WIDTH        128       // OLED width in pixels
 #define OLED_HEIGHT       64        // OLED height in pixels
+#ifndef OLED_SH1106
 #define OLED_SH1106       0         // OLED driver - 0: SSD1306, 1: SH1106
+#endif
 
 #define OLED_BOOT_TIME    50        // OLED boot up time in milliseconds
 #define OLED_INIT_I2C     0         // 1: init I2C with OLED_init()
@@ -97,13 +134,18 @@ extern "C" {
 #define OLED_INVERT       0         // 1: invert screen with OLED_init()
 #define OLED_PORTRAIT     0         // 1: use OLED in portrait mode
 #define OLED_DOUBLEBUF    0         // 1: use double buffer
+#define OLED_BANDED       0         // 1: render page by page from display list (saves RAM)
+#define OLED_DL_SIZE      384       // size of display list in bytes (banded mode)
+#define OLED_PAGE_HASH    0         // 1: don't send pages with unchanged checksum
 
 // OLED Text Settings
 #define OLED_PRINT        0         // 1: include print functions (needs print.h)
 #define OLED_SEG_FONT     1         // 0: standard font, 1: 13x32 digits, 2: 5x16 digits
 #define OLED_SEG_SPACE    5         // width of space between segment digits in pixels
+#define OLED_SEG_CACHE    8         // number of remembered 7-segment cells (digits, point)
 #define OLED_SMOOTH       9         // character size value for double-size smoothed
 #define OLED_STRETCH      10        // character size value for v-stretched
+#define OLED_SMOOTH_TABLE 1         // 1: use precomputed smoothed font (1920 bytes flash)
 
 // OLED Modes
 #define OLED_CMD_MODE     0x00      // set command mode
@@ -138,10 +180,25 @@ extern "C" {
 #define OLED_COMPINS      0xDA      // set COM pin config (following byte)
 #define OLED_VCOM_DETECT  0xDB      // set VCOM detect (following byte)
 
+// OLED Bitmap Modes
+#define OLED_BLIT_OPAQUE  0         // bitmap replaces screen content
+#define OLED_BLIT_SPRITE  1         // set pixels of bitmap are set (transparent)
+#define OLED_BLIT_XOR     2         // set pixels of bitmap invert screen content
+
 #define OLED_abs(n)       (((n)>=0)?(n):(-(n))) // returns positive value of n
 
 // OLED Screen Buffer
 extern uint8_t OLED_buffer[];
+extern uint16_t OLED_sentBytes;
+
+#if OLED_BANDED > 0
+extern uint8_t OLED_dlFull;
+#endif
+
+#if OLED_PAGE_HASH > 0
+extern uint16_t OLED_pagesSent;
+extern uint16_t OLED_pagesSkipped;
+#endif
 
 #if OLED_DOUBLEBUF > 0
 extern uint8_t* OLED_drawbuffer;
@@ -157,12 +214,16 @@ void OLED_flip(uint8_t xflip, uint8_t yflip);
 void OLED_vscroll(uint8_t y);
 void OLED_home(uint8_t x, uint8_t y);
 void OLED_refresh(void);
+void OLED_invalidate(void);
+uint8_t OLED_busy(void);
 
 // OLED Graphics Functions
 void OLED_clear(void);
 void OLED_copy(void);
 uint8_t OLED_getPixel(int16_t x, int16_t y);
 void OLED_setPixel(int16_t x, int16_t y, uint8_t color);
+void OLED_clip(int16_t x, int16_t y, int16_t w, int16_t h);
+void OLED_unclip(void);
 
 void OLED_drawVLine(int16_t x, int16_t y, int16_t h, uint8_t color);
 void OLED_drawHLine(int16_t x, int16_t y, int16_t w, uint8_t color);
@@ -175,6 +236,7 @@ void OLED_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
 void OLED_drawScreen(const uint8_t* bmp);
 void OLED_drawBitmap(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp);
 void OLED_drawSprite(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp);
+void OLED_drawBitmapXOR(int16_t x0, int16_t y0, int16_t w, int16_t h, const uint8_t* bmp);
 
 void OLED_cursor(int16_t x, int16_t y);
 void OLED_textsize(uint8_t size);
@@ -182,6 +244,7 @@ void OLED_textinvert(uint8_t yes);
 void OLED_write(char c);
 void OLED_print(char* str);
 void OLED_printSegment(uint16_t value, uint8_t digits, uint8_t lead, uint8_t decimal);
+void OLED_segInvalidate(void);
 
 #define OLED_flush            OLED_refresh
 #define OLED_textcolor(c)     OLED_textinvert(!(c))
@@ -0,0 +1,200 @@
+// ===================================================================================
+// Smoothed 12x16 Font (chars 32 - 127), generated by tools/smoothfont.c, don't edit
+// ===================================================================================
+
+#pragma once
+
+const uint8_t OLED_FONT_SMOOTH[] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, // '!'
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, // '"'
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x30, 0x30, 0xFF, 0xFF, 0x30, 0x30, 0xFF, 0xFF, 0x30, 0x30, // '#'
+  0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03,
+  0x30, 0x78, 0xFC, 0xCC, 0xFF, 0xFF, 0xCC, 0xCC, 0x8C, 0x0C, // '$'
+  0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x3F, 0x0C, 0x0F, 0x07, 0x03,
+  0x0F, 0x0F, 0x0F, 0x8F, 0xC0, 0xE0, 0x70, 0x38, 0x1C, 0x0C, // '%'
+  0x0C, 0x0E, 0x07, 0x03, 0x01, 0x00, 0x3C, 0x3C, 0x3C, 0x3C,
+  0x3C, 0xFE, 0xE7, 0xE3, 0xF3, 0x3F, 0x1E, 0x0C, 0x00, 0x00, // '&'
+  0x0F, 0x1F, 0x39, 0x31, 0x33, 0x3F, 0x1E, 0x1E, 0x3F, 0x33,
+  0x00, 0x00, 0x30, 0x38, 0x1F, 0x0F, 0x00, 0x00, 0x00, 0x00, // '''
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xF0, 0xF8, 0x1C, 0x0E, 0x07, 0x03, 0x00, 0x00, // '('
+  0x00, 0x00, 0x03, 0x07, 0x0E, 0x1C, 0x38, 0x30, 0x00, 0x00,
+  0x00, 0x00, 0x03, 0x07, 0x0E, 0x1C, 0xF8, 0xF0, 0x00, 0x00, // ')'
+  0x00, 0x00, 0x30, 0x38, 0x1C, 0x0E, 0x07, 0x03, 0x00, 0x00,
+  0x30, 0xF0, 0xE0, 0xC0, 0xFC, 0xFC, 0xC0, 0xE0, 0xF0, 0x30, // '*'
+  0x03, 0x03, 0x01, 0x00, 0x0F, 0x0F, 0x00, 0x01, 0x03, 0x03,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0xFC, 0xC0, 0xC0, 0xC0, 0xC0, // '+'
+  0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ','
+  0x00, 0x00, 0xC0, 0xE0, 0x7C, 0x3C, 0x00, 0x00, 0x00, 0x00,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, // '-'
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '.'
+  0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x80, 0xC0, 0xE0, 0x70, 0x38, 0x1C, 0x0C, // '/'
+  0x0C, 0x0E, 0x07, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xFC, 0xFE, 0x07, 0x83, 0xC3, 0xE3, 0x73, 0x37, 0xFE, 0xFC, // '0'
+  0x0F, 0x1F, 0x3B, 0x33, 0x31, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0x30, 0x38, 0x1C, 0x0C, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, // '1'
+  0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30,
+  0x0C, 0x0E, 0x07, 0x03, 0x03, 0x83, 0xC3, 0xE7, 0x7E, 0x3C, // '2'
+  0x30, 0x30, 0x3C, 0x3E, 0x37, 0x33, 0x31, 0x30, 0x30, 0x30,
+  0x0C, 0x0E, 0x07, 0x03, 0xC3, 0xC3, 0xC3, 0xE7, 0xFE, 0x3C, // '3'
+  0x0C, 0x1C, 0x38, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1F, 0x0F,
+  0xC0, 0xE0, 0x70, 0x38, 0x1C, 0x0C, 0xFF, 0xFF, 0x00, 0x00, // '4'
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03,
+  0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x83, 0x03, // '5'
+  0x0C, 0x1C, 0x38, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1F, 0x0F,
+  0xFC, 0xFE, 0xC7, 0xC3, 0xC3, 0xC3, 0xC3, 0xC7, 0x8E, 0x0C, // '6'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1F, 0x0F,
+  0x0F, 0x0F, 0x03, 0x03, 0x03, 0x83, 0xC3, 0xE3, 0x7F, 0x3F, // '7'
+  0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x01, 0x00, 0x00, 0x00,
+  0x3C, 0xFE, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0xFE, 0x3C, // '8'
+  0x0F, 0x1F, 0x39, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1F, 0x0F,
+  0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xC7, 0xFE, 0xFC, // '9'
+  0x0C, 0x1C, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x00, 0x00, // ':'
+  0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, // ';'
+  0x00, 0x00, 0xC0, 0xE0, 0x7C, 0x3C, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0xC0, 0xE0, 0xF0, 0x38, 0x1C, 0x0C, 0x00, 0x00, // '<'
+  0x00, 0x00, 0x00, 0x01, 0x03, 0x07, 0x0E, 0x0C, 0x00, 0x00,
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, // '='
+  0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+  0x00, 0x00, 0x0C, 0x1C, 0x38, 0xF0, 0xE0, 0xC0, 0x00, 0x00, // '>'
+  0x00, 0x00, 0x0C, 0x0E, 0x07, 0x03, 0x01, 0x00, 0x00, 0x00,
+  0x0C, 0x0E, 0x07, 0x03, 0x03, 0x83, 0xC3, 0xE7, 0x7E, 0x3C, // '?'
+  0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0x01, 0x00, 0x00, 0x00,
+  0xFC, 0xFE, 0x07, 0x03, 0xF3, 0xF3, 0x33, 0x37, 0xFE, 0xFC, // '@'
+  0x0F, 0x1F, 0x38, 0x30, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+  0xF0, 0xF8, 0x1C, 0x0E, 0x07, 0x07, 0x0E, 0x1C, 0xF8, 0xF0, // 'A'
+  0x3F, 0x3F, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x3F, 0x3F,
+  0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0xFE, 0x3C, // 'B'
+  0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1F, 0x0F,
+  0xFC, 0xFE, 0x07, 0x03, 0x03, 0x03, 0x03, 0x07, 0x0E, 0x0C, // 'C'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1C, 0x0C,
+  0xFF, 0xFF, 0x03, 0x03, 0x03, 0x07, 0x0E, 0x1C, 0xF8, 0xF0, // 'D'
+  0x3F, 0x3F, 0x30, 0x30, 0x30, 0x38, 0x1C, 0x0E, 0x07, 0x03,
+  0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x03, 0x03, // 'E'
+  0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0x03, 0x03, // 'F'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xFC, 0xFE, 0x07, 0x03, 0xC3, 0xC3, 0xC3, 0xC7, 0xCE, 0xCC, // 'G'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFF, 0xFF, // 'H'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F,
+  0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, // 'I'
+  0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30,
+  0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0xFF, 0xFF, 0x03, 0x03, // 'J'
+  0x0C, 0x1C, 0x38, 0x30, 0x30, 0x38, 0x1F, 0x0F, 0x00, 0x00,
+  0xFF, 0xFF, 0xC0, 0xE0, 0xF0, 0x38, 0x1C, 0x0E, 0x07, 0x03, // 'K'
+  0x3F, 0x3F, 0x00, 0x01, 0x03, 0x07, 0x0E, 0x1C, 0x38, 0x30,
+  0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 'L'
+  0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0xFF, 0xFF, 0x0C, 0x1C, 0xF8, 0xF8, 0x1C, 0x0C, 0xFF, 0xFF, // 'M'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F,
+  0xFF, 0xFF, 0x30, 0x70, 0xE0, 0xC0, 0x80, 0x00, 0xFF, 0xFF, // 'N'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x01, 0x03, 0x03, 0x3F, 0x3F,
+  0xFC, 0xFE, 0x07, 0x03, 0x03, 0x03, 0x03, 0x07, 0xFE, 0xFC, // 'O'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C, // 'P'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xFC, 0xFE, 0x07, 0x03, 0x03, 0x03, 0x03, 0x07, 0xFE, 0xFC, // 'Q'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0xF0, 0xF8, 0xDF, 0xCF,
+  0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C, // 'R'
+  0x3F, 0x3F, 0x00, 0x00, 0x03, 0x07, 0x0E, 0x1C, 0x38, 0x30,
+  0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xC7, 0x8E, 0x0C, // 'S'
+  0x0C, 0x1C, 0x38, 0x30, 0x30, 0x30, 0x30, 0x39, 0x1F, 0x0F,
+  0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, // 'T'
+  0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00,
+  0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, // 'U'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, // 'V'
+  0x03, 0x07, 0x0E, 0x1C, 0x38, 0x38, 0x1C, 0x0E, 0x07, 0x03,
+  0xFF, 0xFF, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0xFF, 0xFF, // 'W'
+  0x0F, 0x1F, 0x38, 0x38, 0x1F, 0x1F, 0x38, 0x38, 0x1F, 0x0F,
+  0x0F, 0x1F, 0x38, 0xF0, 0xE0, 0xE0, 0xF0, 0x38, 0x1F, 0x0F, // 'X'
+  0x3C, 0x3E, 0x07, 0x03, 0x01, 0x01, 0x03, 0x07, 0x3E, 0x3C,
+  0x3F, 0x7F, 0xE0, 0xC0, 0x80, 0x80, 0xC0, 0xE0, 0x7F, 0x3F, // 'Y'
+  0x00, 0x00, 0x00, 0x01, 0x3F, 0x3F, 0x01, 0x00, 0x00, 0x00,
+  0x03, 0x03, 0x03, 0x83, 0xC3, 0xE3, 0x73, 0x3B, 0x1F, 0x0F, // 'Z'
+  0x3C, 0x3E, 0x37, 0x33, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0x00, 0x00, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, // '['
+  0x00, 0x00, 0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00,
+  0x0C, 0x1C, 0x38, 0x70, 0xE0, 0xC0, 0x80, 0x00, 0x00, 0x00, // '\'
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x07, 0x0E, 0x0C,
+  0x00, 0x00, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF, 0x00, 0x00, // ']'
+  0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F, 0x00, 0x00,
+  0xC0, 0xE0, 0x70, 0x38, 0x1C, 0x1C, 0x38, 0x70, 0xE0, 0xC0, // '^'
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // '_'
+  0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+  0x00, 0x00, 0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C, // '`'
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'a'
+  0x0C, 0x1E, 0x3F, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x3F,
+  0xFF, 0xFF, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'b'
+  0x3F, 0x3F, 0x30, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0xC0, 0xE0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'c'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1C, 0x0C,
+  0xC0, 0xE0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFF, 0xFF, // 'd'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3F, 0x3F,
+  0xC0, 0xE0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'e'
+  0x0F, 0x1F, 0x3B, 0x33, 0x33, 0x33, 0x33, 0x33, 0x03, 0x03,
+  0xC0, 0xC0, 0xFC, 0xFE, 0xC7, 0xC3, 0x03, 0x07, 0x0E, 0x0C, // 'f'
+  0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xC0, 0xE0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'g'
+  0x03, 0x07, 0xCE, 0xCC, 0xCC, 0xCC, 0xCC, 0xEC, 0x7F, 0x3F,
+  0xFF, 0xFF, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'h'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F,
+  0x00, 0x00, 0x30, 0x30, 0xF3, 0xF3, 0x00, 0x00, 0x00, 0x00, // 'i'
+  0x00, 0x00, 0x30, 0x30, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0xF3, 0xF3, 0x00, 0x00, // 'j'
+  0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xE0, 0x7F, 0x3F, 0x00, 0x00,
+  0x03, 0x03, 0xFF, 0xFF, 0x00, 0x80, 0xC0, 0xE0, 0x70, 0x30, // 'k'
+  0x30, 0x30, 0x3F, 0x3F, 0x03, 0x07, 0x0F, 0x1C, 0x38, 0x30,
+  0x00, 0x00, 0x03, 0x03, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, // 'l'
+  0x00, 0x00, 0x30, 0x30, 0x3F, 0x3F, 0x30, 0x30, 0x00, 0x00,
+  0xF0, 0xF0, 0x30, 0x30, 0xF0, 0xF0, 0x30, 0x70, 0xE0, 0xC0, // 'm'
+  0x3F, 0x3F, 0x00, 0x00, 0x3F, 0x3F, 0x00, 0x00, 0x3F, 0x3F,
+  0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'n'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F,
+  0xC0, 0xE0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'o'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0xF0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'p'
+  0xFF, 0xFF, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0E, 0x07, 0x03,
+  0xC0, 0xE0, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0xF0, 0xF0, // 'q'
+  0x03, 0x07, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0xFF, 0xFF,
+  0xF0, 0xF0, 0xC0, 0xE0, 0x70, 0x30, 0x30, 0x70, 0xE0, 0xC0, // 'r'
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xC0, 0xE0, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, // 's'
+  0x00, 0x01, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x1E, 0x0C,
+  0x30, 0x30, 0xFF, 0xFF, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, // 't'
+  0x00, 0x00, 0x0F, 0x1F, 0x38, 0x30, 0x30, 0x38, 0x1C, 0x0C,
+  0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, // 'u'
+  0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F,
+  0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, // 'v'
+  0x03, 0x07, 0x0E, 0x1C, 0x38, 0x38, 0x1C, 0x0E, 0x07, 0x03,
+  0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, // 'w'
+  0x0F, 0x1F, 0x38, 0x38, 0x1F, 0x1F, 0x38, 0x38, 0x1F, 0x0F,
+  0x30, 0x70, 0xE0, 0xC0, 0x80, 0x80, 0xC0, 0xE0, 0x70, 0x30, // 'x'
+  0x30, 0x38, 0x1C, 0x0F, 0x07, 0x07, 0x0F, 0x1C, 0x38, 0x30,
+  0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF0, // 'y'
+  0x03, 0x07, 0xCE, 0xCC, 0xCC, 0xCC, 0xCC, 0xEC, 0x7F, 0x3F,
+  0x30, 0x30, 0x30, 0x30, 0x30, 0xB0, 0xF0, 0xF0, 0x30, 0x30, // 'z'
+  0x30, 0x30, 0x3C, 0x3E, 0x37, 0x33, 0x31, 0x30, 0x30, 0x30,
+  0xC0, 0xC0, 0xC0, 0xE0, 0xFC, 0x3E, 0x07, 0x03, 0x03, 0x03, // '{'
+  0x00, 0x00, 0x00, 0x01, 0x0F, 0x1F, 0x38, 0x30, 0x30, 0x30,
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, // '|'
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+  0x03, 0x03, 0x03, 0x07, 0x3E, 0xFC, 0xE0, 0xC0, 0xC0, 0xC0, // '}'
+  0x30, 0x30, 0x30, 0x38, 0x1F, 0x0F, 0x01, 0x00, 0x00, 0x00,
+  0xC0, 0xE0, 0x70, 0x70, 0xE0, 0xC0, 0x80, 0x80, 0xC0, 0xC0, // '~'
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x03, 0x01, 0x00,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // ' '
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
@@ -0,0 +1,43 @@
+// ===================================================================================
+// Retained-Mode Widgets for SSD1306/SH1106 OLED                              * v1.0 *
+// ===================================================================================
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#include "widget.h"
+
+#if OLED_BANDED > 0
+  #error Widgets need the screen buffer (OLED_BANDED must be 0)
+#endif
+
+// Clear bounding box and draw widget
+void WGT_redraw(WGT_t* w) {
+  #if OLED_DOUBLEBUF == 0
+  while(OLED_busy());                             // wait for screen buffer to be sent
+  #endif
+  OLED_clip(w->x, w->y, w->w, w->h);              // confine drawing to bounding box
+  if(!w->opaque) OLED_fillRect(w->x, w->y, w->w, w->h, 0); // clear bounding box
+  w->draw(w);                                     // draw widget
+  OLED_unclip();
+  w->valid = 1;
+}
+
+// Set value of widget, redraw if it has changed
+uint8_t WGT_update(WGT_t* w, uint16_t value) {
+  if(w->valid && (w->value == value)) return 0;   // nothing changed
+  w->value = value;
+  WGT_redraw(w);
+  return 1;
+}
+
+// Set text of text widget, redraw if it has changed
+uint8_t WGT_updateText(WGT_TEXT_t* w, const char* str) {
+  uint8_t changed = !w->wgt.valid;
+  for(uint8_t i=0; i<WGT_TEXTLEN; i++) {          // compare and copy text
+    if(w->text[i] != str[i]) changed = 1;
+    w->text[i] = str[i];
+    if(!str[i]) break;
+  }
+  if(!changed) return 0;                          // nothing changed
+  WGT_redraw(&w->wgt);
+  return 1;
+}
@@ -0,0 +1,68 @@
+// ===================================================================================
+// Retained-Mode Widgets for SSD1306/SH1106 OLED                              * v1.0 *
+// ===================================================================================
+//
+// A widget is a screen element with a fixed bounding box and a value. It keeps the
+// last drawn value and is only redrawn (bounding box cleared, then drawn by its draw
+// function) when the value changes. Opaque widgets overwrite their bounding box
+// themselves and are not cleared before (e.g. 7-segment digits, which only redraw
+// changed cells). The changed area is marked in the dirty spans of
+// the screen buffer, so OLED_refresh() only sends it.
+//
+// Functions available:
+// --------------------
+// WGT_update(*w,v)         Set value (v) of widget (*w), redraw if it has changed
+// WGT_updateText(*w,*s)    Set text (*s) of text widget (*w), redraw if it has changed
+// WGT_invalidate(*w)       Force redraw of widget (*w) with next update
+//
+// Example:
+// --------
+// void drawVolume(WGT_t* w) { OLED_fillRect(w->x, w->y, w->value, w->h, 1); }
+// WGT_t volWidget = { .x = 50, .y = 58, .w = 16, .h = 3, .draw = drawVolume };
+// WGT_update(&volWidget, volume);
+//
+// Notes:
+// ------
+// - Widgets need the screen buffer, they can't be used in banded mode.
+// - Static screen elements are drawn once, widgets must not overlap them. Widgets are
+//   clipped to their bounding box.
+// - Without double buffer, widgets wait for the last refresh to complete before
+//   they are redrawn.
+//
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ssd1306_gfx.h"
+
+// Widget parameters
+#define WGT_TEXTLEN   8             // max number of characters of text widgets
+
+// Widget descriptor
+typedef struct WGT {
+  int16_t  x, y;                    // position of bounding box
+  uint8_t  w, h;                    // size of bounding box
+  uint8_t  valid;                   // 1: value is drawn
+  uint8_t  opaque;                  // 1: draw function covers the box, no clearing
+  uint16_t value;                   // drawn value
+  void (*draw)(struct WGT* w);      // draw function (bounding box is cleared before)
+} WGT_t;
+
+// Text widget descriptor
+typedef struct {
+  WGT_t    wgt;                     // widget (value is not used)
+  char     text[WGT_TEXTLEN + 1];   // drawn text
+} WGT_TEXT_t;
+
+// Widget functions
+uint8_t WGT_update(WGT_t* w, uint16_t value);           // returns 1 if redrawn
+uint8_t WGT_updateText(WGT_TEXT_t* w, const char* str); // returns 1 if redrawn
+#define WGT_invalidate(w)   ((w)->valid = 0)
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,462 @@
+// ===================================================================================
+// Graphics Benchmark for SSD1306/SH1106 OLED                                 * v1.0 *
+// ===================================================================================
+//
+// Host tool, measures the drawing functions of ssd1306_gfx.c against the baseline
+// implementations they replaced (the original per-pixel versions built on setPixel,
+// included below). Both must draw the same pixels, otherwise the tool fails. The I2C
+// driver is replaced by stubs that emulate the display RAM, so the library runs
+// unchanged on the host and the bus cost of screen updates can be counted. Called by
+// the makefile ("make bench") for SSD1306 and again with -DOLED_SH1106=1 (argument
+// "bus": bus cost only):
+// gcc -O2 -DF_CPU=8000000 -Isrc -o gfxbench tools/gfxbench.c src/ssd1306_gfx.c
+//
+// Times are host nanoseconds per call, best of alternating runs. They show the ratio
+// between both versions, not the cycles on the MCU. Text cases print "FM Radio" (8
+// characters).
+//
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "../src/ssd1306_gfx.h"
+
+#define CALLS           200           // calls of a case per run
+#define RUNS            50            // runs of each version, the fastest one counts
+
+extern const uint8_t OLED_FONT[];                 // standard font of ssd1306_gfx.c
+
+// ===================================================================================
+// I2C Stubs with Display Emulation
+// ===================================================================================
+
+// Transactions complete immediately. The bytes are interpreted like the controller
+// does (horizontal addressing with SSD1306, page addressing with SH1106) and written
+// into the emulated display RAM, bytes and transactions are counted.
+
+uint8_t  RAM[8][132];                             // display RAM (SH1106: 132 columns)
+uint8_t  ramCol, ramPage, colStart, colEnd = 127, pageStart, pageEnd = 7, pageMode;
+uint32_t busBytes, busTrans;                      // incl. address byte
+
+void emulate(const uint8_t* buf, uint16_t len) {
+  uint16_t i = 0;
+  while(i < len) {
+    uint8_t ctrl = buf[i++];                      // control byte
+    uint8_t once = ctrl & 0x80;                   // Co bit: one byte follows
+    while(i < len) {
+      uint8_t b = buf[i++];
+      if(ctrl & OLED_DAT_MODE) {                  // data byte
+        RAM[ramPage][ramCol] = b;
+        if(pageMode) { if(ramCol < 131) ramCol++; }
+        else if(ramCol == colEnd) {
+          ramCol  = colStart;
+          ramPage = (ramPage == pageEnd) ? pageStart : ramPage + 1;
+        }
+        else ramCol++;
+      }
+      else if(b == OLED_COLUMNS) {                // command byte
+        ramCol = colStart = buf[i++]; colEnd = buf[i++]; pageMode = 0;
+      }
+      else if(b == OLED_PAGES) {
+        ramPage = pageStart = buf[i++]; pageEnd = buf[i++]; pageMode = 0;
+      }
+      else if((b & 0xF0) == OLED_PAGE) { ramPage = b & 7; pageMode = 1; }
+      else if((b & 0xF0) == OLED_COLUMN_LOW)  ramCol = (ramCol & 0xF0) | (b & 0x0F);
+      else if((b & 0xF0) == OLED_COLUMN_HIGH) ramCol = (ramCol & 0x0F) | (b << 4);
+      if(once) break;
+    }
+  }
+}
+
+I2C_TRANS_t* queue[16];                           // callbacks may submit transactions
+uint8_t queueHead, queueTail, queueActive;
+
+uint8_t I2C_submit(I2C_TRANS_t* t) {
+  t->status = I2C_TRANS_QUEUED;
+  queue[queueHead++ & 15] = t;
+  if(queueActive) return 0;
+  queueActive = 1;
+  while(queueTail != queueHead) {
+    uint8_t buf[OLED_WIDTH + 16];
+    t = queue[queueTail++ & 15];
+    memcpy(buf, t->pre, t->plen);
+    memcpy(buf + t->plen, t->wbuf, t->wlen);
+    emulate(buf, t->plen + t->wlen);
+    busBytes += t->plen + t->wlen + 1;
+    busTrans++;
+    t->status = I2C_TRANS_DONE;
+    if(t->callback) t->callback(t);
+  }
+  queueActive = 0;
+  return 0;
+}
+
+uint8_t I2C_done(I2C_TRANS_t* t) {
+  return (t->status != I2C_TRANS_QUEUED) && (t->status != I2C_TRANS_ACTIVE);
+}
+
+uint8_t I2C_error;
+void    I2C_init(void) {}
+uint8_t I2C_start(uint8_t addr) { return 0; }
+uint8_t I2C_write(uint8_t data) { return 0; }
+uint8_t I2C_writeBuffer(uint8_t* buf, uint16_t len) { return 0; }
+uint8_t I2C_stop(void) { return 0; }
+uint8_t I2C_busy(void) { return 0; }
+void    I2C_check(void) {}
+void    DLY_ticks(uint32_t n) {}
+
+// ===================================================================================
+// Baseline Drawing Functions (original per-pixel versions, landscape)
+// ===================================================================================
+
+void BASE_setPixel(int16_t x, int16_t y, uint8_t color) {
+  if((x < 0) || (x >= OLED_WIDTH) || (y < 0) || (y >= OLED_HEIGHT)) return;
+  switch(color) {
+    case 0: OLED_buffer[((uint16_t)y >> 3) * OLED_WIDTH + x] &= ~((uint8_t)1 << (y & 7));
+            break;
+    case 1: OLED_buffer[((uint16_t)y >> 3) * OLED_WIDTH + x] |=  ((uint8_t)1 << (y & 7));
+            break;
+    case 2: OLED_buffer[((uint16_t)y >> 3) * OLED_WIDTH + x] ^=  ((uint8_t)1 << (y & 7));
+            break;
+  }
+}
+
+void BASE_drawVLine(int16_t x, int16_t y, int16_t h, uint8_t color) {
+  for(int16_t i=y; i<y+h; i++) BASE_setPixel(x, i, color);
+}
+
+void BASE_drawHLine(int16_t x, int16_t y, int16_t w, uint8_t color) {
+  for(int16_t i=x; i<x+w; i++) BASE_setPixel(i, y, color);
+}
+
+void BASE_fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
+  for(int16_t i=x; i<x+w; i++) BASE_drawVLine(i, y, h, color);
+}
+
+void BASE_drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color) {
+  int16_t dx = OLED_abs(x1 - x0);
+  int16_t sx = x0 < x1 ? 1 : -1;
+  int16_t dy = -OLED_abs(y1 - y0);
+  int16_t sy = y0 < y1 ? 1 : -1;
+  int16_t error = dx + dy;
+  while(1) {
+    BASE_setPixel(x0, y0, color);
+    if(x0 == x1 && y0 == y1) break;
+    int16_t e2 = error * 2;
+    if(e2 >= dy) {
+      if(x0 == x1) break;
+      error += dy;
+      x0 += sx;
+    }
+    if(e2 <= dx) {
+      if(y0 == y1) break;
+      error += dx;
+      y0 += sy;
+    }
+  }
+}
+
+void BASE_fillCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -(r << 1);
+  int16_t x = 0;
+  int16_t y = r;
+  while(x <= y) {
+    BASE_drawVLine(x0 - x, y0 - y, (y << 1) + 1, color);
+    BASE_drawVLine(x0 + x, y0 - y, (y << 1) + 1, color);
+    BASE_drawVLine(x0 - y, y0 - x, (x << 1) + 1, color);
+    BASE_drawVLine(x0 + y, y0 - x, (x << 1) + 1, color);
+    if(f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+  }
+}
+
+int16_t BASE_cx, BASE_cy;                         // cursor position
+uint8_t BASE_ci, BASE_cs = 1;                     // inversion and size
+
+uint16_t BASE_stretch(uint16_t x) {
+  x = (x & 0xF0)<<4 | (x & 0x0F);
+  x = (x<<2 | x) & 0x3333;
+  x = (x<<1 | x) & 0x5555;
+  return x | x<<1;
+}
+
+void BASE_write(char c) {
+  uint16_t ptr = (c & 0x7f) - 32;
+  ptr += ptr << 2;
+
+  // Standard character, if necessary enlarged
+  if(BASE_cs <= 8) {
+    for(uint8_t i=6; i; i--) {
+      uint8_t line, col;
+      int16_t y1 = BASE_cy;
+      line = OLED_FONT[ptr++];
+      if(i == 1) line = 0;
+      if(BASE_ci) line = ~line;
+      for(uint8_t j=0; j<8; j++, line>>=1) {
+        col = line & 1;
+        if(BASE_cs == 1) BASE_setPixel(BASE_cx, y1++, col);
+        else {
+          BASE_fillRect(BASE_cx, y1, BASE_cs, BASE_cs, col);
+          y1 += BASE_cs;
+        }
+      }
+      BASE_cx += BASE_cs;
+    }
+    return;
+  }
+
+  // Double-sized, smoothed character (smoothed at runtime)
+  if(BASE_cs == OLED_SMOOTH) {
+    uint16_t col0L, col0R, col1L, col1R;
+    uint8_t col0 = OLED_FONT[ptr++];
+    col0L = BASE_stretch(col0);
+    col0R = col0L;
+    for(uint8_t col=5; col; col--) {
+      uint8_t col1 = OLED_FONT[ptr++];
+      if(col == 1) col1 = 0;
+      col1L = BASE_stretch(col1);
+      col1R = col1L;
+      for(int8_t i=6; i>=0; i--) {
+        for(int8_t j=1; j<3; j++) {
+          if(((col0>>i & 0b11) == (3 - j)) && ((col1>>i & 0b11) == j)) {
+            col0R = col0R | 1<<((i << 1) + j);
+            col1L = col1L | 1<<((i << 1) + 3 - j);
+          }
+        }
+      }
+      int16_t y1 = BASE_cy;
+      if(BASE_ci) {
+        col0L = ~col0L;
+        col0R = ~col0R;
+      }
+      for(int8_t i=16; i; i--, col0L>>=1, col0R>>=1) {
+        BASE_setPixel(BASE_cx,   y1,   col0L & 1);
+        BASE_setPixel(BASE_cx+1, y1++, col0R & 1);
+      }
+      col0 = col1; col0L = col1L; col0R = col1R; BASE_cx += 2;
+    }
+    BASE_fillRect(BASE_cx, BASE_cy, 2, 16, BASE_ci);
+    BASE_cx += 2;
+    return;
+  }
+
+  // V-stretched character (5x16)
+  for(uint8_t col=6; col; col--) {
+    uint8_t col0 = OLED_FONT[ptr++];
+    if(col == 1) col0 = 0;
+    if(BASE_ci) col0 = ~col0;
+    int16_t y1 = BASE_cy;
+    for(uint8_t i=8; i; i--, col0>>=1) {
+      BASE_setPixel(BASE_cx, y1++, col0 & 1);
+      BASE_setPixel(BASE_cx, y1++, col0 & 1);
+    }
+    BASE_cx++;
+  }
+}
+
+// ===================================================================================
+// Benchmark Cases
+// ===================================================================================
+
+// Drawing functions of one version
+typedef struct {
+  void (*fillRect)(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+  void (*drawHLine)(int16_t x, int16_t y, int16_t w, uint8_t color);
+  void (*drawVLine)(int16_t x, int16_t y, int16_t h, uint8_t color);
+  void (*drawLine)(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
+  void (*fillCircle)(int16_t x0, int16_t y0, int16_t r, uint8_t color);
+  void (*text)(int16_t x, int16_t y, uint8_t size, uint8_t inv, char* str);
+} GFX_t;
+
+void BASE_text(int16_t x, int16_t y, uint8_t size, uint8_t inv, char* str) {
+  BASE_cx = x; BASE_cy = y; BASE_cs = size; BASE_ci = inv;
+  while(*str) BASE_write(*str++);
+}
+
+void OLED_text(int16_t x, int16_t y, uint8_t size, uint8_t inv, char* str) {
+  OLED_cursor(x, y); OLED_textsize(size); OLED_textinvert(inv);
+  OLED_print(str);
+}
+
+const GFX_t BASE = {BASE_fillRect, BASE_drawHLine, BASE_drawVLine, BASE_drawLine,
+                    BASE_fillCircle, BASE_text};
+const GFX_t OLED = {OLED_fillRect, OLED_drawHLine, OLED_drawVLine, OLED_drawLine,
+                    OLED_fillCircle, OLED_text};
+
+void signalBar(const GFX_t* g)  { g->fillRect(100, 60, 20, 3, 1); }
+void fillInvert(const GFX_t* g) { g->fillRect(0, 0, 128, 64, 2); }
+void fillClear(const GFX_t* g)  { g->fillRect(16, 24, 96, 16, 0); }
+void hLine(const GFX_t* g)      { g->drawHLine(0, 37, 128, 1); }
+void vLine(const GFX_t* g)      { g->drawVLine(63, 0, 64, 1); }
+void text2(const GFX_t* g)      { g->text(0, 20, 2, 0, "FM Radio"); }
+void smooth0(const GFX_t* g)    { g->text(0, 0, OLED_SMOOTH, 0, "FM Radio"); }
+void smooth3(const GFX_t* g)    { g->text(0, 3, OLED_SMOOTH, 0, "FM Radio"); }
+void smoothInv(const GFX_t* g)  { g->text(0, 3, OLED_SMOOTH, 1, "FM Radio"); }
+void stretch0(const GFX_t* g)   { g->text(0, 0, OLED_STRETCH, 0, "FM Radio"); }
+void stretch3(const GFX_t* g)   { g->text(0, 3, OLED_STRETCH, 0, "FM Radio"); }
+void stretchInv(const GFX_t* g) { g->text(0, 3, OLED_STRETCH, 1, "FM Radio"); }
+void circle5(const GFX_t* g)    { g->fillCircle(64, 32, 5, 1); }
+void circle20(const GFX_t* g)   { g->fillCircle(64, 32, 20, 1); }
+void circle31(const GFX_t* g)   { g->fillCircle(64, 32, 31, 1); }
+void lineH(const GFX_t* g)      { g->drawLine(0, 10, 127, 10, 1); }
+void lineV(const GFX_t* g)      { g->drawLine(5, 0, 5, 63, 1); }
+void lineSteep(const GFX_t* g)  { g->drawLine(20, 0, 30, 63, 1); }
+void lineFlat(const GFX_t* g)   { g->drawLine(0, 20, 127, 35, 1); }
+void lineDiag(const GFX_t* g)   { g->drawLine(0, 0, 63, 63, 1); }
+
+void volumeBar(const GFX_t* g) {
+  for(uint8_t i=0; i<15; i++) g->fillRect(4 + i * 6, 58, 4, 3, 1);
+}
+
+typedef struct {
+  const char* name;
+  void (*draw)(const GFX_t* g);
+} CASE_t;
+
+const CASE_t CASES[] = {
+  {"signal bar 20x3",           signalBar },
+  {"volume bar 15 x (4x3)",     volumeBar },
+  {"fillRect 128x64 invert",    fillInvert},
+  {"fillRect 96x16 clear",      fillClear },
+  {"drawHLine 128",             hLine     },
+  {"drawVLine 64",              vLine     },
+  {"text size 2",               text2     },
+  {"smoothed, y=0",             smooth0   },
+  {"smoothed, y=3",             smooth3   },
+  {"smoothed inverted, y=3",    smoothInv },
+  {"stretched, y=0",            stretch0  },
+  {"stretched, y=3",            stretch3  },
+  {"stretched inverted, y=3",   stretchInv},
+  {"fillCircle r=5",            circle5   },
+  {"fillCircle r=20",           circle20  },
+  {"fillCircle r=31",           circle31  },
+  {"drawLine horizontal 128",   lineH     },
+  {"drawLine vertical 64",      lineV     },
+  {"drawLine steep 10x63",      lineSteep },
+  {"drawLine flat 127x15",      lineFlat  },
+  {"drawLine diagonal 63x63",   lineDiag  },
+};
+
+// Draw a case with one version on a test pattern, returns a copy of the buffer
+uint8_t pattern[OLED_WIDTH * OLED_HEIGHT / 8];
+void render(const CASE_t* c, const GFX_t* g, uint8_t* out) {
+  memcpy(OLED_buffer, pattern, sizeof(pattern));
+  c->draw(g);
+  memcpy(out, OLED_buffer, sizeof(pattern));
+}
+
+// Time one run of a case, returns ns per call
+double measure(const CASE_t* c, const GFX_t* g) {
+  struct timespec start, stop;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(uint16_t i=0; i<CALLS; i++) c->draw(g);
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  return ((stop.tv_sec - start.tv_sec) * 1e9 + (stop.tv_nsec - start.tv_nsec)) / CALLS;
+}
+
+// ===================================================================================
+// Bus Cost of Screen Updates
+// ===================================================================================
+
+// Screen of the radio (see main.c)
+void drawScreen(void) {
+  OLED_clear();
+  OLED_cursor(94, 36); OLED_textsize(1); OLED_textinvert(0); OLED_print("MHz");
+  OLED_drawRect(104, 20, 24, 7, 1);
+  OLED_cursor(0, 56); OLED_print("Volume:");
+  OLED_drawRect(50, 56, 78, 7, 1);
+  OLED_text(0, 0, OLED_SMOOTH, 0, "FM Radio");
+  OLED_cursor(-10, 20); OLED_printSegment(10110, 5, 1, 2);
+  OLED_fillRect(106, 22, 12, 3, 1);
+}
+
+void fullFrame(void)  { drawScreen(); OLED_invalidate(); }
+void newDigit(void)   { OLED_cursor(-10, 20); OLED_printSegment(10120, 5, 1, 2); }
+void newSignal(void)  { OLED_fillRect(106, 22, 20, 3, 0); OLED_fillRect(106, 22, 15, 3, 1); }
+void newName(void)    { OLED_fillRect(0, 0, 96, 16, 0); OLED_text(0, 0, OLED_SMOOTH, 0, "Radio 1"); }
+
+typedef struct {
+  const char* name;
+  void (*update)(void);
+} UPDATE_t;
+
+const UPDATE_t UPDATES[] = {
+  {"full frame",                fullFrame },
+  {"7-segment digit",           newDigit  },
+  {"signal bar",                newSignal },
+  {"station name",              newName   },
+};
+
+// Refresh the screen, returns 0 if display RAM differs from the screen buffer
+uint8_t refresh(void) {
+  busBytes = 0; busTrans = 0;
+  OLED_refresh();
+  while(OLED_busy());
+  for(uint8_t p=0; p<OLED_HEIGHT/8; p++)
+    for(uint8_t x=0; x<OLED_WIDTH; x++)
+      if(RAM[p][x + OLED_SH1106 * 2] != OLED_buffer[p * OLED_WIDTH + x]) return 0;
+  return 1;
+}
+
+// Print bytes and transactions of each update, bus time at 400kHz with 9 bits per
+// byte and 3 bits per START/STOP
+uint8_t busCost(void) {
+  const uint8_t n = sizeof(UPDATES) / sizeof(UPDATE_t);
+  drawScreen(); OLED_invalidate();
+  if(!refresh()) return 0;
+  printf("Bus cost per refresh (%s):\n", OLED_SH1106 ? "SH1106" : "SSD1306");
+  for(uint8_t i=0; i<n; i++) {
+    UPDATES[i].update();
+    if(!refresh()) {
+      fprintf(stderr, "%s: display differs from buffer\n", UPDATES[i].name);
+      return 0;
+    }
+    printf("  %-28s %5u bytes %3u trans. %6.0f us\n", UPDATES[i].name,
+           busBytes, busTrans, (busBytes * 9 + busTrans * 3) * 2.5);
+  }
+  return 1;
+}
+
+int main(int argc, char** argv) {
+  uint8_t base[sizeof(pattern)], fast[sizeof(pattern)];
+  const uint8_t n = sizeof(CASES) / sizeof(CASE_t);
+
+  if((argc > 1) && !strcmp(argv[1], "bus")) return !busCost(); // bus cost only
+
+  for(uint16_t i=0; i<sizeof(pattern); i++) pattern[i] = i * 0x9D + (i >> 7);
+
+  printf("Drawing functions, best of %u x %u calls, host ns per call:\n", RUNS, CALLS);
+  printf("  %-28s %9s %9s\n", "", "baseline", "current");
+  for(uint8_t i=0; i<n; i++) {
+    const CASE_t* c = &CASES[i];
+    double nsBase = 1e30, nsFast = 1e30;
+
+    // Both versions must draw the same pixels on the same background
+    render(c, &BASE, base);
+    render(c, &OLED, fast);
+    if(memcmp(base, fast, sizeof(pattern))) {
+      fprintf(stderr, "%s: output differs\n", c->name);
+      return 1;
+    }
+
+    // Runs of both versions alternate to see the same host conditions
+    for(uint8_t r=0; r<RUNS; r++) {
+      double ns = measure(c, &BASE);
+      if(ns < nsBase) nsBase = ns;
+      ns = measure(c, &OLED);
+      if(ns < nsFast) nsFast = ns;
+    }
+    printf("  %-28s %9.0f %9.0f\n", c->name, nsBase, nsFast);
+  }
+  return !busCost();
+}
@@ -0,0 +1,310 @@
+// ===================================================================================
+// RDS Decoder Benchmark                                                      * v1.0 *
+// ===================================================================================
+//
+// Host tool, measures the throughput of the table-driven RDS group decoder (rds.c)
+// against a baseline decoder that selects the group handler with an if/else chain.
+// Both decoders must produce the same data from the same group stream, otherwise
+// the tool fails. It also measures the time to the station name (PS) from many start
+// points in the stream, with characters accepted immediately (RDS_PS_FAST) and only
+// if received twice. Called by the makefile ("make bench" or "make bench STREAM=file"):
+// gcc -O2 -o rdsbench tools/rdsbench.c src/rds.c && ./rdsbench [file]
+//
+// Without a file a synthetic station is generated: 0A (PS, AF) and 2A (RT) groups
+// alternating, every 5th group another type, 4A (CT) once a minute. ERRORS percent of
+// the blocks have errors, 1/3 of them uncorrectable with random content. Errors of
+// blocks C and D are not reported, like with the RDA5807. A recorded stream is a text
+// file with one group per line: blocks A-D as hex words, optionally followed by the
+// error levels of blocks A and B as passed to RDS_decode(), e.g.
+// "D313 0548 2D31 414E 0". RDS Spy ASCII logs have this format ("D313 0548 2D31 414E
+// @2024/...", the time stamp is ignored, groups with lost blocks "----" are skipped).
+// Time to name assumes one group every GROUP_MS, so gaps in a recording are missed.
+//
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "../src/rds.h"
+
+#define GROUPS_MAX      4096          // max number of groups in the stream
+#define PASSES          100           // passes over the stream per run
+#define RUNS            50            // runs of each decoder, the fastest one counts
+#define STARTS          200           // start points for the time to name
+#define GROUP_MS        87.6          // time per group (104 bits at 1187.5 bit/s)
+#ifndef ERRORS
+#define ERRORS          5             // blocks with errors in synthetic stream (%)
+#endif
+
+// Group handlers and state of rds.c, shared by both decoders
+extern uint8_t RDS_changed;
+void RDS_group0(const uint16_t* blk, uint8_t clean);
+#if RDS_AF_MAX > 0
+void RDS_group0A(const uint16_t* blk, uint8_t clean);
+#else
+#define RDS_group0A     RDS_group0
+#endif
+#if RDS_RT > 0
+void RDS_group2(const uint16_t* blk, uint8_t clean);
+#endif
+#if RDS_CT > 0
+void RDS_group4A(const uint16_t* blk, uint8_t clean);
+#endif
+
+uint16_t stream[GROUPS_MAX][4];                   // blocks A-D
+uint8_t  errors[GROUPS_MAX];                      // error levels of blocks A and B
+uint8_t  masks[GROUPS_MAX];                       // changed data of baseline decoder
+uint16_t groups;                                  // number of groups in the stream
+
+// Baseline decoder, same as RDS_decode() but with an if/else chain
+uint8_t BASE_decode(const uint16_t* blk, uint8_t err) {
+  uint8_t type, clean;
+  if((err & 0x03) == 0x03) return 0;              // block B uncorrectable: drop group
+  RDS_changed = 0;
+  if(!(err & 0x0C) && (blk[0] != RDS_pi)) {       // block A error-free, new PI?
+    #if RDS_AF_MAX > 0
+    if(RDS_pi) RDS_afCount = 0;                   // other program: clear AF list
+    #endif
+    RDS_pi = blk[0];
+    RDS_changed |= RDS_CHG_PI;
+  }
+  if(!(err & 0x03)) {                             // block B error-free?
+    uint8_t pty = (blk[1] >> 5) & 0x1F;
+    uint8_t tp  = (blk[1] >> 10) & 1;
+    if((pty != RDS_pty) || (tp != RDS_tp)) RDS_changed |= RDS_CHG_PI;
+    RDS_pty = pty;
+    RDS_tp  = tp;
+  }
+  type  = blk[1] >> 11;                           // group type << 1 | version B
+  clean = !err;
+  if(type == 0x00) RDS_group0A(blk, clean);       // 0A: PS, AF
+  else if(type == 0x01) RDS_group0(blk, clean);   // 0B: PS
+  #if RDS_RT > 0
+  else if((type == 0x04) || (type == 0x05)) RDS_group2(blk, clean); // 2A/2B: RT
+  #endif
+  #if RDS_CT > 0
+  else if(type == 0x08) RDS_group4A(blk, clean);  // 4A: CT
+  #endif
+  return RDS_changed;
+}
+
+// Pseudo random number generator (same stream on every host)
+uint32_t seed = 1;
+uint16_t random16(void) {
+  seed = seed * 1103515245 + 12345;
+  return seed >> 16;
+}
+
+// Generate synthetic group stream
+const char NAME[] = "FM RADIO";
+const char TEXT[] = "Synthetic radio text of rdsbench, 16 segments of group type 2A. ";
+
+void generate(void) {
+  for(groups=0; groups<GROUPS_MAX; groups++) {
+    uint16_t* blk = stream[groups];
+    uint8_t   seg = groups / 5;
+    blk[0] = 0xD313;                              // PI
+    blk[1] = (1 << 10) | (10 << 5);               // TP, PTY
+    switch(groups % 5) {
+      case 0: case 2:                             // 0A: PS and AF
+        seg = (groups / 5 * 2 + groups % 5 / 2) & 3;
+        blk[1] |= seg;
+        blk[2] = (0x41 + seg) << 8 | (0x5A + seg);
+        blk[3] = NAME[seg << 1] << 8 | NAME[(seg << 1) + 1];
+        break;
+      case 1: case 3:                             // 2A: RT
+        seg = (groups / 5 * 2 + groups % 5 / 2) & 15;
+        blk[1] |= (2 << 12) | seg;
+        blk[2] = TEXT[seg << 2]       << 8 | TEXT[(seg << 2) + 1];
+        blk[3] = TEXT[(seg << 2) + 2] << 8 | TEXT[(seg << 2) + 3];
+        break;
+      default:
+        if(!(seg % 137)) {                        // 4A: CT once a minute
+          blk[1] |= (4 << 12);                    // MJD 60000, 12:xx UTC, +1h
+          blk[2] = (60000 << 1) & 0xFFFF;
+          blk[3] = ((12 & 0x0F) << 12) | ((seg / 137 % 60) << 6) | 2;
+        }
+        else {                                    // other types
+          uint8_t type = 5 + random16() % 11;
+          blk[1] |= (type << 12) | ((random16() & 1) << 11) | (random16() & 0x1F);
+          blk[2] = random16();
+          blk[3] = random16();
+        }
+    }
+    errors[groups] = 0;
+    for(uint8_t i=0; i<4; i++) {                  // block errors
+      if((random16() % 100) >= ERRORS) continue;
+      uint8_t level = 1 + random16() % 3;
+      if(level == 3) blk[i] = random16();         // uncorrectable: corrupted
+      if(i < 2) errors[groups] |= level << ((1 - i) << 1);
+    }
+  }
+}
+
+// Load recorded group stream
+int load(const char* name) {
+  char line[80];
+  unsigned int blk[4], err;
+  FILE* f = fopen(name, "r");
+  if(!f) return 0;
+  groups = 0;
+  while((groups < GROUPS_MAX) && fgets(line, sizeof(line), f)) {
+    int n = sscanf(line, "%x %x %x %x %x", &blk[0], &blk[1], &blk[2], &blk[3], &err);
+    if(n < 4) continue;                           // no group
+    for(uint8_t i=0; i<4; i++) stream[groups][i] = blk[i];
+    errors[groups++] = (n == 5) ? err : 0;
+  }
+  fclose(f);
+  return groups;
+}
+
+// Decoded data to compare both decoders
+typedef struct {
+  uint16_t pi;
+  uint8_t  pty, tp;
+  char     ps[9];
+  #if RDS_RT > 0
+  char     rt[65];
+  #endif
+  #if RDS_CT > 0
+  uint32_t mjd;
+  uint8_t  hour, minute, ctValid;
+  int8_t   offset;
+  #endif
+  #if RDS_AF_MAX > 0
+  uint8_t  af[RDS_AF_MAX], afCount;
+  #endif
+} RESULT_t;
+
+void snapshot(RESULT_t* r) {
+  memset(r, 0, sizeof(RESULT_t));
+  r->pi = RDS_pi; r->pty = RDS_pty; r->tp = RDS_tp;
+  memcpy(r->ps, RDS_stationName, 9);
+  #if RDS_RT > 0
+  memcpy(r->rt, RDS_radioText, 65);
+  #endif
+  #if RDS_CT > 0
+  r->mjd = RDS_mjd; r->hour = RDS_hour; r->minute = RDS_minute;
+  r->ctValid = RDS_ctValid; r->offset = RDS_offset;
+  #endif
+  #if RDS_AF_MAX > 0
+  memcpy(r->af, RDS_af, RDS_AF_MAX); r->afCount = RDS_afCount;
+  #endif
+}
+
+// Time one run of a decoder, returns ns per group
+double measure(uint8_t (*decode)(const uint16_t*, uint8_t)) {
+  struct timespec start, stop;
+  volatile uint8_t sink = 0;
+  RDS_reset();
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(uint16_t p=0; p<PASSES; p++)
+    for(uint16_t i=0; i<groups; i++) sink |= decode(stream[i], errors[i]);
+  clock_gettime(CLOCK_MONOTONIC, &stop);
+  (void)sink;
+  return ((stop.tv_sec - start.tv_sec) * 1e9 + (stop.tv_nsec - start.tv_nsec))
+         / ((double)PASSES * groups);
+}
+
+// Time to name from STARTS points in the stream. Block A marked as corrected makes
+// every group unclean for the PS decoder, so characters are only accepted twice.
+typedef struct {
+  double shown, shownMax, confirmed, confirmedMax;  // ms
+  uint16_t wrong, incomplete;
+} NAMETIME_t;
+
+void timeToName(uint8_t twice, const char* name, NAMETIME_t* t) {
+  uint16_t n = 0;
+  memset(t, 0, sizeof(NAMETIME_t));
+  for(uint16_t s=0; s<STARTS; s++) {
+    uint16_t shown = 0, confirmed = 0;
+    RDS_reset();
+    for(uint16_t g=1; g<=groups; g++) {
+      uint16_t i = ((uint32_t)s * groups / STARTS + g - 1) % groups;
+      RDS_decode(stream[i], errors[i] | (twice ? 0x04 : 0));
+      if(!shown && (RDS_nameShown == 0xFF)) {
+        shown = g;
+        if(memcmp(RDS_stationName, name, 8)) t->wrong++;
+      }
+      if(RDS_nameMask == 0xFF) {
+        confirmed = g;
+        break;
+      }
+    }
+    if(!confirmed) {
+      t->incomplete++;
+      continue;
+    }
+    n++;
+    t->shown     += shown * GROUP_MS;
+    t->confirmed += confirmed * GROUP_MS;
+    if(shown * GROUP_MS > t->shownMax) t->shownMax = shown * GROUP_MS;
+    if(confirmed * GROUP_MS > t->confirmedMax) t->confirmedMax = confirmed * GROUP_MS;
+  }
+  if(n) {
+    t->shown /= n;
+    t->confirmed /= n;
+  }
+}
+
+int main(int argc, char** argv) {
+  RESULT_t base, table;
+  double nsBase = 1e30, nsTable = 1e30;
+
+  // Group stream
+  if(argc > 1) {
+    if(!load(argv[1])) {
+      fprintf(stderr, "No groups in %s\n", argv[1]);
+      return 1;
+    }
+  }
+  else generate();
+
+  // Both decoders must agree on every group and on the decoded data
+  RDS_reset();
+  for(uint16_t i=0; i<groups; i++) masks[i] = BASE_decode(stream[i], errors[i]);
+  snapshot(&base);
+  RDS_reset();
+  for(uint16_t i=0; i<groups; i++) {
+    if(RDS_decode(stream[i], errors[i]) != masks[i]) {
+      fprintf(stderr, "Decoders differ at group %u\n", i);
+      return 1;
+    }
+  }
+  snapshot(&table);
+  if(memcmp(&base, &table, sizeof(RESULT_t))) {
+    fprintf(stderr, "Decoded data differs\n");
+    return 1;
+  }
+
+  // Throughput, runs of both decoders alternate to see the same host conditions
+  for(uint8_t r=0; r<RUNS; r++) {
+    double ns = measure(BASE_decode);
+    if(ns < nsBase) nsBase = ns;
+    ns = measure(RDS_decode);
+    if(ns < nsTable) nsTable = ns;
+  }
+  printf("%u groups (%s), best of %u x %u passes, results identical\n",
+         groups, (argc > 1) ? argv[1] : "synthetic", RUNS, PASSES);
+  printf("if/else decoder: %6.1f ns/group, %7.0f groups/ms\n", nsBase,  1e6 / nsBase);
+  printf("table decoder:   %6.1f ns/group, %7.0f groups/ms\n", nsTable, 1e6 / nsTable);
+
+  // Time to name, the correct name is the one received twice over the whole stream
+  NAMETIME_t fast, twice;
+  char name[9];
+  RDS_reset();
+  for(uint16_t i=0; i<groups; i++) RDS_decode(stream[i], errors[i] | 0x04);
+  memcpy(name, RDS_stationName, 9);
+  timeToName(0, name, &fast);
+  timeToName(1, name, &twice);
+  printf("Time to name \"%s\", %u starts, %.1f ms per group:\n", name, STARTS, GROUP_MS);
+  printf("                 shown mean/max    confirmed mean/max  wrong  incomplete\n");
+  printf("twice only:      %5.0f / %5.0f ms   %5.0f / %5.0f ms   %5u  %5u\n",
+         twice.shown, twice.shownMax, twice.confirmed, twice.confirmedMax,
+         twice.wrong, twice.incomplete);
+  printf("immediate:       %5.0f / %5.0f ms   %5.0f / %5.0f ms   %5u  %5u\n",
+         fast.shown, fast.shownMax, fast.confirmed, fast.confirmedMax,
+         fast.wrong, fast.incomplete);
+  return 0;
+}
@@ -0,0 +1,72 @@
+// ===================================================================================
+// Smoothed Font Generator for SSD1306/SH1106 OLED                            * v1.0 *
+// ===================================================================================
+//
+// Host tool, generates the smoothed double-size font (12x16: 10x16 pixels plus 2
+// columns space) from the standard 5x8 font using David Johnson-Davies' Smooth Big Text
+// algorithm and writes it as C header to stdout. Called by the makefile:
+// gcc -o smoothfont tools/smoothfont.c && ./smoothfont > src/ssd1306_smooth.h
+//
+// Each character consists of 2 bitmap rows of 10 bytes (upper and lower 8 pixels).
+//
+// References:
+// -----------
+// - David Johnson-Davies:  http://www.technoblogy.com/show?3AJ7
+//
+// 2024 by Stefan Wagner:   https://github.com/wagiminator
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../src/ssd1306_font.h"
+
+// Converts bit pattern abcdefgh into aabbccddeeffgghh
+uint16_t stretch(uint16_t x) {
+  x = (x & 0xF0)<<4 | (x & 0x0F);
+  x = (x<<2 | x) & 0x3333;
+  x = (x<<1 | x) & 0x5555;
+  return x | x<<1;
+}
+
+// Smooth one character into 10 columns of 16 pixels
+void smooth(uint8_t c, uint16_t* out) {
+  uint16_t ptr = (c - 32) * 5;
+  uint16_t col0L, col0R, col1L, col1R;
+  uint8_t  col0 = OLED_FONT[ptr++];
+  col0L = stretch(col0);
+  col0R = col0L;
+  for(uint8_t col=5; col; col--) {
+    uint8_t col1 = (col == 1) ? 0 : OLED_FONT[ptr++];
+    col1L = stretch(col1);
+    col1R = col1L;
+    for(int8_t i=6; i>=0; i--) {
+      for(int8_t j=1; j<3; j++) {
+        if(((col0>>i & 0b11) == (3 - j)) && ((col1>>i & 0b11) == j)) {
+          col0R = col0R | 1<<((i << 1) + j);
+          col1L = col1L | 1<<((i << 1) + 3 - j);
+        }
+      }
+    }
+    *out++ = col0L;
+    *out++ = col0R;
+    col0 = col1; col0L = col1L; col0R = col1R;
+  }
+}
+
+int main(void) {
+  uint16_t cols[10];
+  printf("// ===================================================================================\n");
+  printf("// Smoothed 12x16 Font (chars 32 - 127), generated by tools/smoothfont.c, don't edit\n");
+  printf("// ===================================================================================\n\n");
+  printf("#pragma once\n\n");
+  printf("const uint8_t OLED_FONT_SMOOTH[] = {\n");
+  for(uint8_t c=32; c<128; c++) {
+    smooth(c, cols);
+    printf(" ");
+    for(uint8_t i=0; i<10; i++) printf(" 0x%02X,", cols[i] & 0xFF);
+    printf(" // '%c'\n ", (c == 127) ? ' ' : c);
+    for(uint8_t i=0; i<10; i++) printf(" 0x%02X%s", cols[i] >> 8, (c == 127 && i == 9) ? "" : ",");
+    printf("\n");
+  }
+  printf("};\n");
+  return 0;
+}